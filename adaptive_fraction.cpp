@@ -0,0 +1,369 @@
+#include "adaptive_fraction.hpp"
+
+namespace sss
+{
+    constexpr adaptive_fraction::adaptive_fraction(void) noexcept:
+        as32{0},
+        bits{32}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T> && (sizeof(T) <= sizeof(std::int64_t))
+    constexpr adaptive_fraction::adaptive_fraction(const fraction<T>& x) noexcept:
+        as32{0},
+        bits{32}
+    {
+        if constexpr(std::same_as<T, std::int32_t>)
+        {
+            this->as32 = x;
+        }
+        else if(!x.is_finite())
+        {
+            this->as32 = fraction<std::int32_t>{static_cast<std::int32_t>(x.signum()), 0};
+        }
+        else
+        {
+            *this = from_128({x.get_numer(), x.get_denom()});
+        }
+    }
+    template<typename T> requires nonbool_integral<T> && (sizeof(T) <= sizeof(std::int64_t))
+    constexpr adaptive_fraction::adaptive_fraction(T value) noexcept:
+        adaptive_fraction{fraction<T>{value}}
+    {
+
+    }
+
+    constexpr std::size_t adaptive_fraction::get_width(void) const noexcept
+    {
+        return this->bits;
+    }
+    constexpr wide::int128_t adaptive_fraction::get_numer(void) const noexcept
+    {
+        switch(this->bits)
+        {
+            case 32:
+                return this->as32.get_numer();
+            case 64:
+                return this->as64.get_numer();
+            default:
+                return this->as128.numer;
+        }
+    }
+    constexpr wide::uint128_t adaptive_fraction::get_denom(void) const noexcept
+    {
+        switch(this->bits)
+        {
+            case 32:
+                return this->as32.get_denom();
+            case 64:
+                return this->as64.get_denom();
+            default:
+                return static_cast<wide::uint128_t>(this->as128.denom);
+        }
+    }
+    constexpr bool adaptive_fraction::is_nan(void) const noexcept
+    {
+        return this->get_numer() == 0 && this->get_denom() == 0;
+    }
+    constexpr bool adaptive_fraction::is_infinite(void) const noexcept
+    {
+        return this->get_numer() != 0 && this->get_denom() == 0;
+    }
+    constexpr bool adaptive_fraction::is_finite(void) const noexcept
+    {
+        return this->get_denom() != 0;
+    }
+    constexpr bool adaptive_fraction::is_zero(void) const noexcept
+    {
+        return this->get_numer() == 0 && this->get_denom() != 0;
+    }
+    constexpr int adaptive_fraction::signum(void) const noexcept
+    {
+        wide::int128_t numer {this->get_numer()};
+        return (numer > 0) - (numer < 0);
+    }
+
+    constexpr adaptive_fraction::operator fraction<std::int64_t>(void) const noexcept
+    {
+        return this->bits == 128 ? arithmetic::narrow(this->as128) : this->to_64();
+    }
+    template<typename F> requires std::floating_point<F>
+    constexpr adaptive_fraction::operator F(void) const noexcept
+    {
+        switch(this->bits)
+        {
+            case 32:
+                return static_cast<F>(this->as32);
+            case 64:
+                return static_cast<F>(this->as64);
+            default:
+                return static_cast<F>(this->as128.numer)/static_cast<F>(this->as128.denom);
+        }
+    }
+
+    constexpr adaptive_fraction adaptive_fraction::operator+(const adaptive_fraction& rhs) const noexcept
+    {
+        return apply<op::add>(*this, rhs);
+    }
+    constexpr adaptive_fraction adaptive_fraction::operator-(const adaptive_fraction& rhs) const noexcept
+    {
+        return apply<op::sub>(*this, rhs);
+    }
+    constexpr adaptive_fraction adaptive_fraction::operator*(const adaptive_fraction& rhs) const noexcept
+    {
+        return apply<op::mul>(*this, rhs);
+    }
+    constexpr adaptive_fraction adaptive_fraction::operator/(const adaptive_fraction& rhs) const noexcept
+    {
+        return apply<op::div>(*this, rhs);
+    }
+    constexpr adaptive_fraction adaptive_fraction::operator-(void) const noexcept
+    {
+        return adaptive_fraction{} - *this;
+    }
+    constexpr adaptive_fraction& adaptive_fraction::operator+=(const adaptive_fraction& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+    constexpr adaptive_fraction& adaptive_fraction::operator-=(const adaptive_fraction& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+    constexpr adaptive_fraction& adaptive_fraction::operator*=(const adaptive_fraction& rhs) noexcept
+    {
+        return *this = *this*rhs;
+    }
+    constexpr adaptive_fraction& adaptive_fraction::operator/=(const adaptive_fraction& rhs) noexcept
+    {
+        return *this = *this/rhs;
+    }
+
+    // Cross products of values up to 64 bits wide fit in 128 bits; only wider values need the continued fractions
+    // of fused_arithmetic::compare.
+    constexpr std::partial_ordering adaptive_fraction::operator<=>(const adaptive_fraction& rhs) const noexcept
+    {
+        if(this->is_nan() || rhs.is_nan())
+        {
+            return std::partial_ordering::unordered;
+        }
+        if(!this->is_finite() || !rhs.is_finite())
+        {
+            return (this->is_finite() ? 0 : this->signum()) <=> (rhs.is_finite() ? 0 : rhs.signum());
+        }
+        if(this->bits == 32 && rhs.bits == 32)
+        {
+            std::int64_t lhs_cross {std::int64_t{this->as32.get_numer()}*std::int64_t{rhs.as32.get_denom()}};
+            std::int64_t rhs_cross {std::int64_t{rhs.as32.get_numer()}*std::int64_t{this->as32.get_denom()}};
+            return lhs_cross <=> rhs_cross;
+        }
+        if(this->bits != 128 && rhs.bits != 128)
+        {
+            return this->get_numer()*static_cast<wide::int128_t>(rhs.get_denom())
+                <=> rhs.get_numer()*static_cast<wide::int128_t>(this->get_denom());
+        }
+        return arithmetic::compare(this->to_128(), rhs.to_128());
+    }
+    constexpr bool adaptive_fraction::operator==(const adaptive_fraction& rhs) const noexcept
+    {
+        return (*this <=> rhs) == 0;
+    }
+
+    // Infinities, NaN and division by zero give the same result whatever the magnitude of a finite operand, so a
+    // 128-bit one is replaced by its sign and the operation done at 64 bits.
+    template<adaptive_fraction::op Op>
+    constexpr adaptive_fraction adaptive_fraction::apply(
+        const adaptive_fraction& a,
+        const adaptive_fraction& b
+    ) noexcept
+    {
+        if(a.bits == 32 && b.bits == 32)
+        {
+            std::optional<fraction<std::int32_t>> y {checked<Op>(a.as32, b.as32)};
+            if(y)
+            {
+                return adaptive_fraction{*y};
+            }
+        }
+        if(a.bits != 128 && b.bits != 128)
+        {
+            std::optional<fraction<std::int64_t>> y {checked<Op>(a.to_64(), b.to_64())};
+            if(y)
+            {
+                return from_64(*y);
+            }
+        }
+        if(!a.is_finite() || !b.is_finite() || (Op == op::div && b.is_zero()))
+        {
+            auto bound = [](const adaptive_fraction& x)
+            {
+                return x.bits == 128 ? fraction<std::int64_t>{x.signum()} : x.to_64();
+            };
+            return from_64(eager<Op>(bound(a), bound(b)));
+        }
+        std::optional<arithmetic::exact> x {widened<Op>(a.to_128(), b.to_128())};
+        if(x)
+        {
+            return from_128(arithmetic::reduce(*x));
+        }
+        return widest<Op>(a.to_128(), b.to_128());
+    }
+    template<adaptive_fraction::op Op, typename T> requires nonbool_integral<T>
+    constexpr std::optional<fraction<T>> adaptive_fraction::checked(const fraction<T>& a, const fraction<T>& b) noexcept
+    {
+        if constexpr(Op == op::add)
+        {
+            return a.checked_add(b);
+        }
+        else if constexpr(Op == op::sub)
+        {
+            return a.checked_sub(b);
+        }
+        else if constexpr(Op == op::mul)
+        {
+            return a.checked_mul(b);
+        }
+        else
+        {
+            return a.checked_div(b);
+        }
+    }
+    template<adaptive_fraction::op Op>
+    constexpr std::optional<fused_arithmetic<std::int64_t>::exact> adaptive_fraction::widened(
+        const arithmetic::exact& a,
+        const arithmetic::exact& b
+    ) noexcept
+    {
+        if constexpr(Op == op::add)
+        {
+            return arithmetic::add(a, b);
+        }
+        else if constexpr(Op == op::sub)
+        {
+            return arithmetic::sub(a, b);
+        }
+        else if constexpr(Op == op::mul)
+        {
+            return arithmetic::mul(a, b);
+        }
+        else
+        {
+            return arithmetic::div(a, b);
+        }
+    }
+    template<adaptive_fraction::op Op>
+    constexpr fraction<std::int64_t> adaptive_fraction::eager(
+        const fraction<std::int64_t>& a,
+        const fraction<std::int64_t>& b
+    ) noexcept
+    {
+        if constexpr(Op == op::add)
+        {
+            return a + b;
+        }
+        else if constexpr(Op == op::sub)
+        {
+            return a - b;
+        }
+        else if constexpr(Op == op::mul)
+        {
+            return a*b;
+        }
+        else
+        {
+            return a/b;
+        }
+    }
+
+    // The operands are reduced, as fused_arithmetic's wide operations need, and so is the result. When that is still
+    // too wide for 128 bits, its continued fraction is walked in 256 bits to the nearest 64-bit fraction.
+    template<adaptive_fraction::op Op>
+    constexpr adaptive_fraction adaptive_fraction::widest(
+        const arithmetic::exact& a,
+        const arithmetic::exact& b
+    ) noexcept
+    {
+        using wide_exact = arithmetic::wide_exact;
+        wide_exact x {arithmetic::widen(a)};
+        wide_exact y {arithmetic::widen(b)};
+        wide_exact z {};
+        if constexpr(Op == op::add)
+        {
+            z = arithmetic::wide_add(x, y);
+        }
+        else if constexpr(Op == op::sub)
+        {
+            z = arithmetic::wide_sub(x, y);
+        }
+        else if constexpr(Op == op::mul)
+        {
+            z = arithmetic::wide_mul(x, y);
+        }
+        else
+        {
+            z = arithmetic::wide_div(x, y);
+        }
+        if(wide::bit_width(z.numer) < 128 && wide::bit_width(z.denom) < 128)
+        {
+            wide::int128_t n {static_cast<wide::int128_t>(z.numer.low)};
+            return from_128({z.negative ? -n : n, static_cast<wide::int128_t>(z.denom.low)});
+        }
+        raise_inexact();
+        return from_64(arithmetic::nearest(z.negative, z.numer, z.denom));
+    }
+
+    constexpr adaptive_fraction adaptive_fraction::from_64(const fraction<std::int64_t>& x) noexcept
+    {
+        adaptive_fraction y {};
+        if(
+            x.get_numer() >= std::numeric_limits<std::int32_t>::min()
+            && x.get_numer() <= std::numeric_limits<std::int32_t>::max()
+            && x.get_denom() <= std::numeric_limits<std::uint32_t>::max()
+        )
+        {
+            y.as32 = fraction<std::int32_t>{
+                reduced,
+                static_cast<std::int32_t>(x.get_numer()),
+                static_cast<std::uint32_t>(x.get_denom())
+            };
+            return y;
+        }
+        y.as64 = x;
+        y.bits = 64;
+        return y;
+    }
+    constexpr adaptive_fraction adaptive_fraction::from_128(const arithmetic::exact& x) noexcept
+    {
+        if(
+            x.numer >= std::numeric_limits<std::int64_t>::min()
+            && x.numer <= std::numeric_limits<std::int64_t>::max()
+            && x.denom <= std::numeric_limits<std::uint64_t>::max()
+        )
+        {
+            return from_64(fraction<std::int64_t>{
+                reduced,
+                static_cast<std::int64_t>(x.numer),
+                static_cast<std::uint64_t>(x.denom)
+            });
+        }
+        adaptive_fraction y {};
+        y.as128 = x;
+        y.bits = 128;
+        return y;
+    }
+    constexpr fraction<std::int64_t> adaptive_fraction::to_64(void) const noexcept
+    {
+        if(this->bits == 32)
+        {
+            return fraction<std::int64_t>{reduced, this->as32.get_numer(), this->as32.get_denom()};
+        }
+        return this->as64;
+    }
+    constexpr fused_arithmetic<std::int64_t>::exact adaptive_fraction::to_128(void) const noexcept
+    {
+        if(this->bits == 128)
+        {
+            return this->as128;
+        }
+        return {this->get_numer(), static_cast<wide::int128_t>(this->get_denom())};
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "fraction.hpp"
+#include "fused.hpp"
+#include "status.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // A fraction as wide as its value: a fraction<std::int32_t> while it fits, a fraction<std::int64_t> when it does
+    // not, and a reduced 128-bit numerator and denominator beyond that. An operation starts with the checked
+    // operation at the width of its wider operand and moves up a width each time that fails, where fraction<T> would
+    // approximate, and the result is stored at the narrowest width it fits. Small values therefore cost one checked
+    // operation of fraction<int> and a test of the width.
+    //
+    // Only a result that does not fit in 128 bits even when reduced is approximated, by the nearest
+    // fraction<std::int64_t>, raising the inexact flag.
+    class adaptive_fraction
+    {
+        private:
+            using arithmetic = fused_arithmetic<std::int64_t>;
+
+            enum class op
+            {
+                add,
+                sub,
+                mul,
+                div
+            };
+
+            union
+            {
+                fraction<std::int32_t> as32;
+                fraction<std::int64_t> as64;
+                arithmetic::exact as128;
+            };
+            std::uint8_t bits;
+
+        public:
+            constexpr adaptive_fraction(void) noexcept;
+            template<typename T> requires nonbool_integral<T> && (sizeof(T) <= sizeof(std::int64_t))
+            constexpr adaptive_fraction(const fraction<T>& x) noexcept;
+            template<typename T> requires nonbool_integral<T> && (sizeof(T) <= sizeof(std::int64_t))
+            constexpr adaptive_fraction(T value) noexcept;
+
+            // 32, 64 or 128.
+            [[nodiscard]] constexpr std::size_t get_width(void) const noexcept;
+            [[nodiscard]] constexpr wide::int128_t get_numer(void) const noexcept;
+            [[nodiscard]] constexpr wide::uint128_t get_denom(void) const noexcept;
+            [[nodiscard]] constexpr bool is_nan(void) const noexcept;
+            [[nodiscard]] constexpr bool is_infinite(void) const noexcept;
+            [[nodiscard]] constexpr bool is_finite(void) const noexcept;
+            [[nodiscard]] constexpr bool is_zero(void) const noexcept;
+            [[nodiscard]] constexpr int signum(void) const noexcept;
+
+            // The value, or the nearest fraction<std::int64_t> to it, raising the inexact flag.
+            [[nodiscard]] constexpr explicit operator fraction<std::int64_t>(void) const noexcept;
+            template<typename F> requires std::floating_point<F>
+            [[nodiscard]] constexpr explicit operator F(void) const noexcept;
+
+            [[nodiscard]] constexpr adaptive_fraction operator+(const adaptive_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr adaptive_fraction operator-(const adaptive_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr adaptive_fraction operator*(const adaptive_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr adaptive_fraction operator/(const adaptive_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr adaptive_fraction operator-(void) const noexcept;
+            constexpr adaptive_fraction& operator+=(const adaptive_fraction& rhs) noexcept;
+            constexpr adaptive_fraction& operator-=(const adaptive_fraction& rhs) noexcept;
+            constexpr adaptive_fraction& operator*=(const adaptive_fraction& rhs) noexcept;
+            constexpr adaptive_fraction& operator/=(const adaptive_fraction& rhs) noexcept;
+            [[nodiscard]] constexpr std::partial_ordering operator<=>(const adaptive_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr bool operator==(const adaptive_fraction& rhs) const noexcept;
+
+        private:
+            template<op Op>
+            [[nodiscard]] static constexpr adaptive_fraction apply(
+                const adaptive_fraction& a,
+                const adaptive_fraction& b
+            ) noexcept;
+            template<op Op, typename T> requires nonbool_integral<T>
+            [[nodiscard]] static constexpr std::optional<fraction<T>> checked(
+                const fraction<T>& a,
+                const fraction<T>& b
+            ) noexcept;
+            template<op Op>
+            [[nodiscard]] static constexpr std::optional<arithmetic::exact> widened(
+                const arithmetic::exact& a,
+                const arithmetic::exact& b
+            ) noexcept;
+            // The result in 256 bits, stored exactly when it fits in 128 once reduced and otherwise as the nearest
+            // fraction<std::int64_t>.
+            template<op Op>
+            [[nodiscard]] static constexpr adaptive_fraction widest(
+                const arithmetic::exact& a,
+                const arithmetic::exact& b
+            ) noexcept;
+            template<op Op>
+            [[nodiscard]] static constexpr fraction<std::int64_t> eager(
+                const fraction<std::int64_t>& a,
+                const fraction<std::int64_t>& b
+            ) noexcept;
+
+            // x stored at the narrowest width it fits; x must be reduced.
+            [[nodiscard]] static constexpr adaptive_fraction from_64(const fraction<std::int64_t>& x) noexcept;
+            [[nodiscard]] static constexpr adaptive_fraction from_128(const arithmetic::exact& x) noexcept;
+            // The value at 64 bits, when it is no wider.
+            [[nodiscard]] constexpr fraction<std::int64_t> to_64(void) const noexcept;
+            // The value at 128 bits, when it is finite.
+            [[nodiscard]] constexpr arithmetic::exact to_128(void) const noexcept;
+    };
+}
+
+#include "adaptive_fraction.cpp"
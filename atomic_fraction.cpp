@@ -0,0 +1,227 @@
+#include "atomic_fraction.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr atomic_fraction<T>::atomic_fraction(void) noexcept:
+        atomic_fraction{fraction<T>{}}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr atomic_fraction<T>::atomic_fraction(const fraction<T>& x) noexcept:
+        word{to_word(x)},
+        lock{}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    bool atomic_fraction<T>::is_lock_free(void) const noexcept
+    {
+        if constexpr(double_word)
+        {
+            return !locked;
+        }
+        else
+        {
+            return this->word.is_lock_free();
+        }
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::load(std::memory_order order) const noexcept
+    {
+        return from_word(this->load_word(order));
+    }
+    template<typename T> requires nonbool_integral<T>
+    void atomic_fraction<T>::store(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        if constexpr(double_word)
+        {
+            static_cast<void>(this->exchange(x, order));
+        }
+        else
+        {
+            this->word.store(to_word(x), order);
+        }
+    }
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::exchange(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        if constexpr(double_word)
+        {
+            return this->update([&x](const fraction<T>&)
+            {
+                return x;
+            }, order);
+        }
+        else
+        {
+            return from_word(this->word.exchange(to_word(x), order));
+        }
+    }
+    template<typename T> requires nonbool_integral<T>
+    bool atomic_fraction<T>::compare_exchange_weak(
+        fraction<T>& expected,
+        const fraction<T>& desired,
+        std::memory_order success,
+        std::memory_order failure
+    ) noexcept
+    {
+        word_t x {to_word(expected)};
+        bool exchanged {this->compare_exchange_word(x, to_word(desired), true, success, failure)};
+        expected = from_word(x);
+        return exchanged;
+    }
+    template<typename T> requires nonbool_integral<T>
+    bool atomic_fraction<T>::compare_exchange_strong(
+        fraction<T>& expected,
+        const fraction<T>& desired,
+        std::memory_order success,
+        std::memory_order failure
+    ) noexcept
+    {
+        word_t x {to_word(expected)};
+        bool exchanged {this->compare_exchange_word(x, to_word(desired), false, success, failure)};
+        expected = from_word(x);
+        return exchanged;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::fetch_add(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        return this->update([&x](const fraction<T>& y)
+        {
+            return y + x;
+        }, order);
+    }
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::fetch_sub(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        return this->update([&x](const fraction<T>& y)
+        {
+            return y - x;
+        }, order);
+    }
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::fetch_mul(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        return this->update([&x](const fraction<T>& y)
+        {
+            return y*x;
+        }, order);
+    }
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> atomic_fraction<T>::fetch_div(const fraction<T>& x, std::memory_order order) noexcept
+    {
+        return this->update([&x](const fraction<T>& y)
+        {
+            return y/x;
+        }, order);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    atomic_fraction<T>::operator fraction<T>(void) const noexcept
+    {
+        return this->load();
+    }
+    template<typename T> requires nonbool_integral<T>
+    atomic_fraction<T>& atomic_fraction<T>::operator=(const fraction<T>& x) noexcept
+    {
+        this->store(x);
+        return *this;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename atomic_fraction<T>::word_t atomic_fraction<T>::to_word(const fraction<T>& x) noexcept
+    {
+        return std::bit_cast<word_t>(x);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> atomic_fraction<T>::from_word(word_t x) noexcept
+    {
+        return std::bit_cast<fraction<T>>(x);
+    }
+
+    // A compare-and-swap of zero with zero reads the double word without changing it.
+    template<typename T> requires nonbool_integral<T>
+    typename atomic_fraction<T>::word_t atomic_fraction<T>::load_word(std::memory_order order) const noexcept
+    {
+        if constexpr(!double_word)
+        {
+            return this->word.load(order);
+        }
+        else if constexpr(locked)
+        {
+            while(this->lock.test_and_set(std::memory_order_acquire))
+            {
+            }
+            word_t x {this->word};
+            this->lock.clear(std::memory_order_release);
+            return x;
+        }
+        else
+        {
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+            return __sync_val_compare_and_swap(&this->word, word_t{0}, word_t{0});
+#endif
+        }
+    }
+    template<typename T> requires nonbool_integral<T>
+    bool atomic_fraction<T>::compare_exchange_word(
+        word_t& expected,
+        word_t desired,
+        bool weak,
+        std::memory_order success,
+        std::memory_order failure
+    ) noexcept
+    {
+        if constexpr(!double_word)
+        {
+            if(weak)
+            {
+                return this->word.compare_exchange_weak(expected, desired, success, failure);
+            }
+            return this->word.compare_exchange_strong(expected, desired, success, failure);
+        }
+        else if constexpr(locked)
+        {
+            while(this->lock.test_and_set(std::memory_order_acquire))
+            {
+            }
+            bool exchanged {this->word == expected};
+            if(exchanged)
+            {
+                this->word = desired;
+            }
+            else
+            {
+                expected = this->word;
+            }
+            this->lock.clear(std::memory_order_release);
+            return exchanged;
+        }
+        else
+        {
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+            word_t x {__sync_val_compare_and_swap(&this->word, expected, desired)};
+            bool exchanged {x == expected};
+            expected = x;
+            return exchanged;
+#endif
+        }
+    }
+
+    // A failed compare_exchange leaves the current value in x, so each retry recomputes from what it saw.
+    template<typename T> requires nonbool_integral<T>
+    template<typename F>
+    fraction<T> atomic_fraction<T>::update(F f, std::memory_order order) noexcept
+    {
+        word_t x {this->load_word(std::memory_order_relaxed)};
+        while(!this->compare_exchange_word(x, to_word(f(from_word(x))), true, order, std::memory_order_relaxed))
+        {
+        }
+        return from_word(x);
+    }
+}
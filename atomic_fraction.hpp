@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // A fraction<T> that can be read and updated from several threads at once, for shared rational counters such as
+    // accumulated play time. The numerator and denominator are held together in one word, so a reader never sees
+    // one without the other. Up to 32-bit T that word is 64 bits or less and lives in a std::atomic. The 128-bit
+    // word of a 64-bit T is updated with cmpxchg16b when the target has it (-mcx16 on x86-64, which defines
+    // __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16), and is otherwise guarded by a spinlock.
+    //
+    // compare_exchange compares representations, which for reduced fractions is the same as comparing values,
+    // except that NaN compares equal to itself. The fetch operations are compare_exchange loops around the ordinary
+    // operators and return the previous value.
+    template<typename T> requires nonbool_integral<T>
+    class atomic_fraction
+    {
+        private:
+            using word_t = std::conditional_t<sizeof(T) == 1, std::uint16_t,
+                std::conditional_t<sizeof(T) == 2, std::uint32_t,
+                std::conditional_t<sizeof(T) == 4, std::uint64_t, wide::uint128_t>>>;
+
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+            static constexpr bool locked {false};
+#else
+            static constexpr bool locked {sizeof(word_t) > sizeof(std::uint64_t)};
+#endif
+            static constexpr bool double_word {sizeof(word_t) > sizeof(std::uint64_t)};
+
+            struct no_lock
+            {
+            };
+
+            // The __sync builtins need the plain word, and read it by writing to it, hence mutable.
+            alignas(sizeof(word_t)) mutable std::conditional_t<double_word, word_t, std::atomic<word_t>> word;
+            [[no_unique_address]] mutable std::conditional_t<locked, std::atomic_flag, no_lock> lock;
+
+        public:
+            static constexpr bool is_always_lock_free {!locked};
+
+            constexpr atomic_fraction(void) noexcept;
+            constexpr atomic_fraction(const fraction<T>& x) noexcept;
+            atomic_fraction(const atomic_fraction&) = delete;
+            atomic_fraction& operator=(const atomic_fraction&) = delete;
+
+            [[nodiscard]] bool is_lock_free(void) const noexcept;
+
+            // The double-word and locked forms are sequentially consistent whatever order is asked for.
+            [[nodiscard]] fraction<T> load(std::memory_order order = std::memory_order_seq_cst) const noexcept;
+            void store(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+            fraction<T> exchange(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+            bool compare_exchange_weak(
+                fraction<T>& expected,
+                const fraction<T>& desired,
+                std::memory_order success = std::memory_order_seq_cst,
+                std::memory_order failure = std::memory_order_seq_cst
+            ) noexcept;
+            bool compare_exchange_strong(
+                fraction<T>& expected,
+                const fraction<T>& desired,
+                std::memory_order success = std::memory_order_seq_cst,
+                std::memory_order failure = std::memory_order_seq_cst
+            ) noexcept;
+
+            fraction<T> fetch_add(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+            fraction<T> fetch_sub(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+            fraction<T> fetch_mul(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+            fraction<T> fetch_div(const fraction<T>& x, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+            [[nodiscard]] operator fraction<T>(void) const noexcept;
+            atomic_fraction& operator=(const fraction<T>& x) noexcept;
+
+        private:
+            [[nodiscard]] static constexpr word_t to_word(const fraction<T>& x) noexcept;
+            [[nodiscard]] static constexpr fraction<T> from_word(word_t x) noexcept;
+
+            [[nodiscard]] word_t load_word(std::memory_order order) const noexcept;
+            bool compare_exchange_word(
+                word_t& expected,
+                word_t desired,
+                bool weak,
+                std::memory_order success,
+                std::memory_order failure
+            ) noexcept;
+            template<typename F>
+            fraction<T> update(F f, std::memory_order order) noexcept;
+    };
+}
+
+#include "atomic_fraction.cpp"
@@ -0,0 +1,794 @@
+// Micro-benchmarks for every operator, integer width and operand distribution. Build with optimizations, e.g.
+// `g++ -std=c++23 -O2 bench.cpp -o bench`, and once more with -DSSS_FRACTION_NO_LUT to measure the generic template
+// for 8-bit and 16-bit fractions. With -DSSS_FRACTION_STATS the approximation counters are printed at the end.
+//
+//   bench [--n N] [--repeats R] [--budget-ms MS] [--seed S] [--filter TEXT]
+//
+// A human-readable table goes to stderr and a JSON document with every result goes to stdout, so
+// `bench > results.json` can be diffed against an earlier run. --filter keeps only the benchmarks whose
+// "type distribution op" name contains TEXT.
+//
+// Each repeat walks the N operands in doubling batches and stops early once it has used its time budget, because
+// overflowing 64-bit products spend tens of milliseconds in the approximation loops. The JSON "n" is the number of
+// operations behind the reported figure.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adaptive_fraction.hpp"
+#include "atomic_fraction.hpp"
+#include "continued_fraction.hpp"
+#include "farey.hpp"
+#include "fixed_fraction.hpp"
+#include "fraction.hpp"
+#include "fused.hpp"
+#include "lazy.hpp"
+#include "lut.hpp"
+#include "packed_fraction.hpp"
+#include "rescale.hpp"
+#include "sharded_fraction_sum.hpp"
+#include "sort.hpp"
+#include "stats.hpp"
+#include "wide.hpp"
+
+template<typename T>
+inline void do_not_optimize(const T& x)
+{
+    asm volatile("" : : "r,m"(x) : "memory");
+}
+
+struct options
+{
+    std::size_t n {1 << 14};
+    int repeats {5};
+    double budget_ms {200.0};
+    std::uint64_t seed {42};
+    std::string filter {};
+};
+
+struct result
+{
+    std::string type;
+    std::string distribution;
+    std::string op;
+    std::size_t n;
+    double ns_per_op;
+};
+
+options opts {};
+std::vector<result> results {};
+
+template<typename F>
+void measure(const char* type, const char* distribution, const char* op, std::size_t n, F f)
+{
+    std::string name {std::string{type} + " " + distribution + " " + op};
+    if(name.find(opts.filter) == std::string::npos)
+    {
+        return;
+    }
+    double best {1e300};
+    std::size_t best_n {0};
+    for(int r {0}; r < opts.repeats; ++r)
+    {
+        std::chrono::duration<double, std::nano> elapsed {0};
+        std::size_t done {0};
+        for(std::size_t batch {1}; done < n && elapsed.count() < opts.budget_ms*1e6; batch *= 2)
+        {
+            std::size_t end {std::min(n, done + batch)};
+            auto start {std::chrono::steady_clock::now()};
+            for(std::size_t i {done}; i < end; ++i)
+            {
+                do_not_optimize(f(i));
+            }
+            elapsed += std::chrono::steady_clock::now() - start;
+            done = end;
+        }
+        if(elapsed.count()/static_cast<double>(done) < best)
+        {
+            best = elapsed.count()/static_cast<double>(done);
+            best_n = done;
+        }
+    }
+    std::fprintf(stderr, "%-56s %14.3f ns/op %12.0f op/s\n", name.c_str(), best, 1e9/best);
+    results.push_back({type, distribution, op, best_n, best});
+}
+
+enum class distribution
+{
+    small,
+    full,
+    fibonacci,
+    overflow
+};
+
+constexpr const char* distribution_names[] {"small", "full", "fibonacci", "overflow"};
+
+template<typename T>
+struct operands
+{
+    std::vector<T> numers;
+    std::vector<std::make_unsigned_t<T>> denoms;
+    std::vector<sss::fraction<T>> a;
+    std::vector<sss::fraction<T>> b;
+    std::vector<T> c;
+    std::vector<T> c_below;
+    std::vector<T> c_above;
+    std::vector<sss::fraction<T>> nonnegative;
+};
+
+// Small operands stay on the fast checked paths; full-range operands are what random data looks like; consecutive
+// Fibonacci numbers make Euclid take the most steps for their size; overflow operands sit in the top half of the
+// range so that almost every sum and product falls through to the approximation loops.
+//
+// Unsigned differences must stay clear of zero: the approximation loop shrinks both operands independently, and once
+// the approximations cross it cannot converge and spins until its divisor wraps. For unsigned T the pairs are
+// ordered so that a >= 2b, compared exactly at 128 bits because operator<=> cross-multiplies in T, and
+// c_below/c_above hold integers at most half of a and at least twice a for f - i and i - f.
+template<typename T>
+operands<T> make_operands(distribution dist, std::size_t n, std::mt19937_64& rng)
+{
+    using U = std::make_unsigned_t<T>;
+    using N = std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>;
+    constexpr T max {std::numeric_limits<T>::max()};
+    constexpr U umax {std::numeric_limits<U>::max()};
+
+    std::vector<U> fibonacci {1, 1};
+    while(fibonacci.back() <= umax - fibonacci[fibonacci.size() - 2]
+        && fibonacci.back() + fibonacci[fibonacci.size() - 2] <= static_cast<U>(max))
+    {
+        fibonacci.push_back(fibonacci.back() + fibonacci[fibonacci.size() - 2]);
+    }
+    std::uniform_int_distribution<std::size_t> fibonacci_index {1, fibonacci.size() - 1};
+    std::uniform_int_distribution<int> coin {0, 1};
+    auto sign {[&](N x)
+    {
+        return static_cast<T>(std::is_signed<T>::value && coin(rng) != 0 ? -x : x);
+    }};
+
+    std::uniform_int_distribution<N> small_numer {std::is_signed<T>::value ? -15 : 0, 15};
+    std::uniform_int_distribution<unsigned long long> small_denom {1, 16};
+    std::uniform_int_distribution<N> full_numer {std::numeric_limits<T>::min(), max};
+    std::uniform_int_distribution<unsigned long long> full_denom {1, umax};
+    std::uniform_int_distribution<N> high_numer {max/2 + 1, max};
+    std::uniform_int_distribution<unsigned long long> high_denom {umax/2 + 1, umax};
+
+    auto draw {[&]() -> std::pair<T, U>
+    {
+        switch(dist)
+        {
+            case distribution::small:
+                return {static_cast<T>(small_numer(rng)), static_cast<U>(small_denom(rng))};
+            case distribution::full:
+                return {static_cast<T>(full_numer(rng)), static_cast<U>(full_denom(rng))};
+            case distribution::fibonacci:
+            {
+                std::size_t i {fibonacci_index(rng)};
+                return {sign(static_cast<N>(fibonacci[i])), fibonacci[i - 1]};
+            }
+            case distribution::overflow:
+                return {sign(high_numer(rng)), static_cast<U>(high_denom(rng))};
+        }
+        return {};
+    }};
+
+    operands<T> x {};
+    x.numers.reserve(n);
+    x.denoms.reserve(n);
+    x.a.reserve(n);
+    x.b.reserve(n);
+    x.c.reserve(n);
+    x.c_below.reserve(n);
+    x.c_above.reserve(n);
+    x.nonnegative.reserve(n);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        auto [numer, denom] {draw()};
+        auto [numer2, denom2] {draw()};
+        sss::fraction<T> a {numer, denom};
+        sss::fraction<T> b {numer2, denom2};
+        T c {draw().first};
+        T c_below {c};
+        T c_above {c};
+        if constexpr(!std::is_signed<T>::value)
+        {
+            if(sss::wide::uint128_t(a.get_numer())*b.get_denom() < sss::wide::uint128_t(b.get_numer())*a.get_denom())
+            {
+                std::swap(a, b);
+            }
+            b = {static_cast<T>(b.get_numer()/2), b.get_denom()};
+            c_below = std::min<T>(c, a.floor()/2);
+            c_above = a.ceil() > max/2 ? max : std::max<T>(c, static_cast<T>(a.ceil()*2));
+        }
+        x.numers.push_back(numer);
+        x.denoms.push_back(denom);
+        x.a.push_back(a);
+        x.b.push_back(b);
+        x.c.push_back(c);
+        x.c_below.push_back(c_below);
+        x.c_above.push_back(c_above);
+        x.nonnegative.push_back(
+            a.get_numer() < 0 ? sss::fraction<T>{static_cast<T>(-(a.get_numer() + 1)), a.get_denom()} : a
+        );
+    }
+    return x;
+}
+
+// What sss::sqrt replaces: std::sqrt on the double, then the continued fraction of the result cut off at the same
+// bounds as the fraction.
+template<typename T>
+sss::fraction<T> from_double(double x)
+{
+    using U = std::make_unsigned_t<T>;
+    sss::wide::uint128_t h0 {0};
+    sss::wide::uint128_t k0 {1};
+    sss::wide::uint128_t h1 {1};
+    sss::wide::uint128_t k1 {0};
+    while(x < 1e19)
+    {
+        double a {std::floor(x)};
+        sss::wide::uint128_t h {static_cast<sss::wide::uint128_t>(a)*h1 + h0};
+        sss::wide::uint128_t k {static_cast<sss::wide::uint128_t>(a)*k1 + k0};
+        if(h > std::numeric_limits<T>::max() || k > std::numeric_limits<U>::max())
+        {
+            break;
+        }
+        h0 = h1;
+        k0 = k1;
+        h1 = h;
+        k1 = k;
+        if(x == a)
+        {
+            break;
+        }
+        x = 1/(x - a);
+    }
+    if(k1 == 0)
+    {
+        return std::numeric_limits<sss::fraction<T>>::max();
+    }
+    return {sss::reduced, static_cast<T>(h1), static_cast<U>(k1)};
+}
+
+template<typename T>
+void bench(const char* type, distribution dist, std::mt19937_64& rng)
+{
+    const std::size_t n {opts.n};
+    const char* name {distribution_names[static_cast<int>(dist)]};
+    operands<T> x {make_operands<T>(dist, n, rng)};
+    auto each {[&](const char* op, auto f)
+    {
+        measure(type, name, op, n, f);
+    }};
+
+    each("fraction{n, d}", [&](std::size_t i) { return sss::fraction<T>{x.numers[i], x.denoms[i]}; });
+    each("fraction{n}", [&](std::size_t i) { return sss::fraction<T>{x.numers[i]}; });
+    each("fraction{reduced, n, d}", [&](std::size_t i)
+    {
+        return sss::fraction<T>{sss::reduced, x.a[i].get_numer(), x.a[i].get_denom()};
+    });
+    each("f + f", [&](std::size_t i) { return x.a[i] + x.b[i]; });
+    each("f - f", [&](std::size_t i) { return x.a[i] - x.b[i]; });
+    each("f * f", [&](std::size_t i) { return x.a[i]*x.b[i]; });
+    each("f / f", [&](std::size_t i) { return x.a[i]/x.b[i]; });
+    each("f % f", [&](std::size_t i) { return x.a[i] % x.b[i]; });
+    each("f + i", [&](std::size_t i) { return x.a[i] + x.c[i]; });
+    each("f - i", [&](std::size_t i) { return x.a[i] - x.c_below[i]; });
+    each("f * i", [&](std::size_t i) { return x.a[i]*x.c[i]; });
+    each("f / i", [&](std::size_t i) { return x.a[i]/x.c[i]; });
+    each("f % i", [&](std::size_t i) { return x.a[i] % x.c[i]; });
+    each("i + f", [&](std::size_t i) { return x.c[i] + x.a[i]; });
+    each("i - f", [&](std::size_t i) { return x.c_above[i] - x.a[i]; });
+    each("i * f", [&](std::size_t i) { return x.c[i]*x.a[i]; });
+    each("i / f", [&](std::size_t i) { return x.c[i]/x.a[i]; });
+    each("i % f", [&](std::size_t i) { return x.c[i] % x.a[i]; });
+    each("f == f", [&](std::size_t i) { return x.a[i] == x.b[i]; });
+    each("f < f", [&](std::size_t i) { return x.a[i] < x.b[i]; });
+    each("f <=> i", [&](std::size_t i) { return x.a[i] <=> x.c[i]; });
+    each("pow(3)", [&](std::size_t i) { return x.a[i].pow(3); });
+    each("recip", [&](std::size_t i) { return x.a[i].recip(); });
+    each("floor", [&](std::size_t i) { return x.a[i].floor(); });
+    each("round", [&](std::size_t i) { return x.a[i].round(); });
+    each("double(f)", [&](std::size_t i) { return static_cast<double>(x.a[i]); });
+    each("T(f)", [&](std::size_t i) { return static_cast<T>(x.a[i]); });
+    each("std::string(f)", [&](std::size_t i) { return static_cast<std::string>(x.a[i]); });
+    each("sqrt", [&](std::size_t i) { return sss::sqrt(x.nonnegative[i]); });
+    each("sqrt via double", [&](std::size_t i)
+    {
+        return from_double<T>(std::sqrt(static_cast<double>(x.nonnegative[i])));
+    });
+}
+
+template<typename T>
+void bench_all(const char* type, std::mt19937_64& rng)
+{
+    for(distribution dist : {distribution::small, distribution::full, distribution::fibonacci, distribution::overflow})
+    {
+        bench<T>(type, dist, rng);
+    }
+}
+
+void bench_gcd(std::mt19937_64& rng)
+{
+    const std::size_t n {opts.n*16};
+    std::vector<std::uint8_t> x(n);
+    std::vector<std::uint8_t> y(n);
+    std::uniform_int_distribution<unsigned> byte {0, 255};
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        x[i] = static_cast<std::uint8_t>(byte(rng));
+        y[i] = static_cast<std::uint8_t>(byte(rng));
+    }
+    measure("uint8_t", "full", "std::gcd", n, [&](std::size_t i) { return std::gcd(x[i], y[i]); });
+    measure("uint8_t", "full", "sss::lut::gcd", n, [&](std::size_t i) { return sss::lut::gcd(x[i], y[i]); });
+}
+
+// Building a table of every reduced fraction in [0, 1] with a bounded denominator, once from the Farey recurrence
+// and once the obvious way (reduce every pair, sort, deduplicate). One op is one whole table.
+void bench_farey(void)
+{
+    constexpr int order {500};
+    measure("int", "order 500", "farey table", 16, [&](std::size_t)
+    {
+        std::vector<sss::fraction<int>> table {};
+        for(sss::fraction<int> x : sss::farey(order))
+        {
+            table.push_back(x);
+        }
+        return table.size();
+    });
+    measure("int", "order 500", "pairs, sort, unique", 16, [&](std::size_t)
+    {
+        std::vector<sss::fraction<int>> table {};
+        for(int q {1}; q <= order; ++q)
+        {
+            for(int p {0}; p <= q; ++p)
+            {
+                table.push_back(sss::fraction<int>{p, static_cast<unsigned>(q)});
+            }
+        }
+        std::ranges::sort(table);
+        table.erase(std::unique(table.begin(), table.end()), table.end());
+        return table.size();
+    });
+}
+
+// Sorting a million fractions small enough that operator< does not overflow, so that std::sort is a fair baseline.
+// One op is one whole sort of a fresh copy.
+template<typename T>
+void bench_sort(const char* type, T limit, std::mt19937_64& rng)
+{
+    std::vector<sss::fraction<T>> x {};
+    std::uniform_int_distribution<T> numer {static_cast<T>(-limit), limit};
+    std::uniform_int_distribution<T> denom {1, limit};
+    for(std::size_t i {0}; i < 1000000; ++i)
+    {
+        x.push_back({numer(rng), static_cast<std::make_unsigned_t<T>>(denom(rng))});
+    }
+    measure(type, "1M", "std::sort", 4, [&](std::size_t)
+    {
+        std::vector<sss::fraction<T>> y {x};
+        std::sort(y.begin(), y.end());
+        return y.front();
+    });
+    measure(type, "1M", "std::sort, 128-bit compare", 4, [&](std::size_t)
+    {
+        std::vector<sss::fraction<T>> y {x};
+        std::sort(y.begin(), y.end(), [](sss::fraction<T> a, sss::fraction<T> b)
+        {
+            return sss::wide::int128_t{a.get_numer()}*b.get_denom() < sss::wide::int128_t{b.get_numer()}*a.get_denom();
+        });
+        return y.front();
+    });
+    measure(type, "1M", "sss::sort", 4, [&](std::size_t)
+    {
+        std::vector<sss::fraction<T>> y {x};
+        sss::sort(y);
+        return y.front();
+    });
+    measure(type, "1M", "sss::parallel_sort", 4, [&](std::size_t)
+    {
+        std::vector<sss::fraction<T>> y {x};
+        sss::parallel_sort(y);
+        return y.front();
+    });
+}
+
+// Tick counts in a 1/48000 timebase, once as fixed_fraction and once as the equivalent fraction.
+void bench_fixed(std::mt19937_64& rng)
+{
+    using audio = sss::fixed_fraction<int, 48000>;
+    const std::size_t n {opts.n};
+    std::vector<audio> a(n);
+    std::vector<audio> b(n);
+    std::vector<sss::fraction<int>> fa(n);
+    std::vector<sss::fraction<int>> fb(n);
+    std::uniform_int_distribution<int> ticks {-1000000, 1000000};
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        a[i] = audio::from_ticks(ticks(rng));
+        b[i] = audio::from_ticks(ticks(rng));
+        fa[i] = static_cast<sss::fraction<int>>(a[i]);
+        fb[i] = static_cast<sss::fraction<int>>(b[i]);
+    }
+    measure("int", "ticks/48000", "fixed + fixed", n, [&](std::size_t i) { return a[i] + b[i]; });
+    measure("int", "ticks/48000", "fraction + fraction", n, [&](std::size_t i) { return fa[i] + fb[i]; });
+    measure("int", "ticks/48000", "fixed < fixed", n, [&](std::size_t i) { return a[i] < b[i]; });
+    measure("int", "ticks/48000", "fraction < fraction", n, [&](std::size_t i) { return fa[i] < fb[i]; });
+    measure("int", "ticks/48000", "fixed -> fraction", n, [&](std::size_t i)
+    {
+        return static_cast<sss::fraction<int>>(a[i]);
+    });
+}
+
+// Presentation times in a 1/48000 timebase converted to 1/90000, rounding to nearest.
+void bench_rescale(std::mt19937_64& rng)
+{
+    using f64 = sss::fraction<long long>;
+    const std::size_t n {opts.n};
+    std::vector<long long> ticks(n);
+    std::uniform_int_distribution<long long> any {-(1LL << 40), 1LL << 40};
+    for(long long& t : ticks)
+    {
+        t = any(rng);
+    }
+    const f64 from {1, 48000};
+    const f64 to {1, 90000};
+    measure("long long", "1/48000 -> 1/90000", "sss::rescale", n, [&](std::size_t i)
+    {
+        return sss::rescale(ticks[i], from, to, sss::rounding::nearest_away);
+    });
+    measure("long long", "1/48000 -> 1/90000", "fraction * fraction, round", n, [&](std::size_t i)
+    {
+        return (f64{ticks[i]}*(from/to)).round();
+    });
+}
+
+// Event times at 1/48000 snapped to a 24 fps frame grid, one at a time, as a batch, and through fraction arithmetic.
+void bench_quantize(std::mt19937_64& rng)
+{
+    using f64 = sss::fraction<long long>;
+    const std::size_t n {opts.n};
+    std::vector<f64> x(n);
+    std::vector<long long> ticks(n);
+    std::uniform_int_distribution<long long> any {-(1LL << 40), 1LL << 40};
+    for(f64& t : x)
+    {
+        t = f64{any(rng), 48000};
+    }
+    measure("long long", "ticks/48000 -> 1/24", "sss::quantize_ticks", n, [&](std::size_t i)
+    {
+        return sss::quantize_ticks(x[i], 24u, sss::rounding::nearest_even);
+    });
+    measure("long long", "ticks/48000 -> 1/24", "sss::quantize_ticks, 1024 per op", n/1024, [&](std::size_t i)
+    {
+        return sss::quantize_ticks<long long>(std::span{x}.subspan(i*1024, 1024), 24u, sss::rounding::nearest_even,
+            std::span{ticks}.subspan(i*1024, 1024));
+    });
+    measure("long long", "ticks/48000 -> 1/24", "(x*24).round()", n, [&](std::size_t i)
+    {
+        return (x[i]*f64{24}).round();
+    });
+}
+
+// A 64-tap filter with Q15 coefficients over integer samples, and fma on the same operands.
+void bench_fused(std::mt19937_64& rng)
+{
+    using f = sss::fraction<int>;
+    const std::size_t n {opts.n};
+    std::uniform_int_distribution<int> q15 {-32768, 32767};
+    std::uniform_int_distribution<int> sample {-32768, 32767};
+    std::vector<f> taps(64);
+    for(f& t : taps)
+    {
+        t = f{q15(rng), 32768};
+    }
+    std::vector<f> samples(n + taps.size());
+    for(f& x : samples)
+    {
+        x = f{sample(rng)};
+    }
+    measure("int", "64 Q15 taps", "sss::dot", n, [&](std::size_t i)
+    {
+        return sss::dot<int>(taps, std::span{samples}.subspan(i, taps.size()));
+    });
+    measure("int", "64 Q15 taps", "sum of products", n, [&](std::size_t i)
+    {
+        f y {0};
+        for(std::size_t j {0}; j < taps.size(); ++j)
+        {
+            y = y + taps[j]*samples[i + j];
+        }
+        return y;
+    });
+    measure("int", "Q15", "sss::fma", n, [&](std::size_t i)
+    {
+        return sss::fma(taps[i % taps.size()], samples[i], taps[(i + 1) % taps.size()]);
+    });
+    measure("int", "Q15", "a*b + c", n, [&](std::size_t i)
+    {
+        return taps[i % taps.size()]*samples[i] + taps[(i + 1) % taps.size()];
+    });
+}
+
+// (a + b)*c - d/e over random operands, as one lazy expression and with the ordinary operators.
+void bench_lazy(std::mt19937_64& rng)
+{
+    using f = sss::fraction<int>;
+    const std::size_t n {opts.n};
+    std::uniform_int_distribution<int> numer {-1000, 1000};
+    std::uniform_int_distribution<int> denom {1, 1000};
+    std::vector<f> x(n + 4);
+    for(f& y : x)
+    {
+        y = f{numer(rng), static_cast<unsigned int>(denom(rng))};
+    }
+    measure("int", "uniform 1000", "lazy (a + b)*c - d/e", n, [&](std::size_t i)
+    {
+        return f{(sss::lazy(x[i]) + x[i + 1])*x[i + 2] - sss::lazy(x[i + 3])/x[i + 4]};
+    });
+    measure("int", "uniform 1000", "(a + b)*c - d/e", n, [&](std::size_t i)
+    {
+        return (x[i] + x[i + 1])*x[i + 2] - x[i + 3]/x[i + 4];
+    });
+}
+
+// Ratios with 20-bit numerators and 12-bit denominators, packed into 4 bytes and as 8-byte fraction<int>.
+void bench_packed(std::mt19937_64& rng)
+{
+    using packed = sss::packed_fraction<32, 20>;
+    using f = sss::fraction<int>;
+    const std::size_t n {opts.n};
+    std::uniform_int_distribution<int> numer {packed::min_numer, packed::max_numer};
+    std::uniform_int_distribution<unsigned int> denom {1, packed::max_denom};
+    std::vector<packed> pa(n);
+    std::vector<packed> pb(n);
+    std::vector<f> fa(n);
+    std::vector<f> fb(n);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        fa[i] = f{numer(rng), denom(rng)};
+        fb[i] = f{numer(rng), denom(rng)};
+        pa[i] = packed{fa[i]};
+        pb[i] = packed{fb[i]};
+    }
+    measure("int", "20/12 bits", "packed_fraction<32, 20> +", n, [&](std::size_t i)
+    {
+        return pa[i] + pb[i];
+    });
+    measure("int", "20/12 bits", "fraction +", n, [&](std::size_t i)
+    {
+        return fa[i] + fb[i];
+    });
+    measure("int", "20/12 bits", "packed_fraction<32, 20> *", n, [&](std::size_t i)
+    {
+        return pa[i]*pb[i];
+    });
+    measure("int", "20/12 bits", "fraction *", n, [&](std::size_t i)
+    {
+        return fa[i]*fb[i];
+    });
+    measure("int", "20/12 bits", "packed_fraction<32, 20> unpack", n, [&](std::size_t i)
+    {
+        return pa[i].unpack();
+    });
+}
+
+// Small operands, whose sums and products still fit in fraction<int>, so adaptive_fraction stays at 32 bits.
+void bench_adaptive(std::mt19937_64& rng)
+{
+    using f = sss::fraction<int>;
+    using g = sss::fraction<long long>;
+    const std::size_t n {opts.n};
+    std::uniform_int_distribution<int> numer {-30000, 30000};
+    std::uniform_int_distribution<unsigned int> denom {1, 30000};
+    std::vector<sss::adaptive_fraction> aa(n);
+    std::vector<sss::adaptive_fraction> ab(n);
+    std::vector<f> fa(n);
+    std::vector<f> fb(n);
+    std::vector<g> ga(n);
+    std::vector<g> gb(n);
+    for(std::size_t i {0}; i < n; ++i)
+    {
+        fa[i] = f{numer(rng), denom(rng)};
+        fb[i] = f{numer(rng), denom(rng)};
+        aa[i] = fa[i];
+        ab[i] = fb[i];
+        ga[i] = g{fa[i].get_numer(), fa[i].get_denom()};
+        gb[i] = g{fb[i].get_numer(), fb[i].get_denom()};
+    }
+    measure("int", "fits int", "adaptive_fraction +", n, [&](std::size_t i)
+    {
+        return aa[i] + ab[i];
+    });
+    measure("int", "fits int", "fraction +", n, [&](std::size_t i)
+    {
+        return fa[i] + fb[i];
+    });
+    measure("int", "fits int", "fraction<long long> +", n, [&](std::size_t i)
+    {
+        return ga[i] + gb[i];
+    });
+    measure("int", "fits int", "adaptive_fraction *", n, [&](std::size_t i)
+    {
+        return aa[i]*ab[i];
+    });
+    measure("int", "fits int", "fraction *", n, [&](std::size_t i)
+    {
+        return fa[i]*fb[i];
+    });
+    measure("int", "fits int", "fraction<long long> *", n, [&](std::size_t i)
+    {
+        return ga[i]*gb[i];
+    });
+}
+
+// Four threads adding 1/48000 to one shared counter, 4096 times each, through atomic_fraction, sharded_fraction_sum
+// and under a mutex, where each operation is one whole run of the threads; and the same additions from one thread.
+template<typename T>
+void bench_atomic(const char* type)
+{
+    using f = sss::fraction<T>;
+    constexpr int threads {4};
+    constexpr int adds {4096};
+    auto contend = [](auto add)
+    {
+        std::vector<std::thread> workers {};
+        for(int t {0}; t < threads; ++t)
+        {
+            workers.emplace_back([&add]()
+            {
+                for(int i {0}; i < adds; ++i)
+                {
+                    add();
+                }
+            });
+        }
+        for(std::thread& w : workers)
+        {
+            w.join();
+        }
+    };
+    measure(type, "4 threads x 4096", "atomic_fraction fetch_add", 64, [&](std::size_t)
+    {
+        sss::atomic_fraction<T> x {};
+        contend([&x]()
+        {
+            x.fetch_add(f{1, 48000});
+        });
+        return x.load();
+    });
+    measure(type, "4 threads x 4096", "sharded_fraction_sum +=", 64, [&](std::size_t)
+    {
+        sss::sharded_fraction_sum<T> x {threads};
+        contend([&x]()
+        {
+            x += f{1, 48000};
+        });
+        return x.load();
+    });
+    measure(type, "4 threads x 4096", "mutex fraction +=", 64, [&](std::size_t)
+    {
+        std::mutex m {};
+        f x {};
+        contend([&]()
+        {
+            std::lock_guard<std::mutex> lock {m};
+            x += f{1, 48000};
+        });
+        return x;
+    });
+    sss::atomic_fraction<T> shared {};
+    measure(type, "uncontended", "atomic_fraction fetch_add", opts.n, [&](std::size_t)
+    {
+        return shared.fetch_add(f{1, 48000});
+    });
+    std::mutex m {};
+    f guarded {};
+    measure(type, "uncontended", "mutex fraction +=", opts.n, [&](std::size_t)
+    {
+        std::lock_guard<std::mutex> lock {m};
+        return guarded += f{1, 48000};
+    });
+}
+
+void print_json(const char* variant)
+{
+    std::printf("{\n  \"variant\": \"%s\",\n  \"compiler\": \"%s\",\n  \"n\": %zu,\n  \"repeats\": %d,\n"
+        "  \"budget_ms\": %g,\n  \"seed\": %llu,\n  \"results\": [\n", variant, __VERSION__, opts.n, opts.repeats,
+        opts.budget_ms, static_cast<unsigned long long>(opts.seed));
+    for(std::size_t i {0}; i < results.size(); ++i)
+    {
+        const result& r {results[i]};
+        std::printf("    {\"type\": \"%s\", \"distribution\": \"%s\", \"op\": \"%s\", \"n\": %zu, "
+            "\"ns_per_op\": %.4f, \"ops_per_s\": %.1f}%s\n", r.type.c_str(), r.distribution.c_str(), r.op.c_str(),
+            r.n, r.ns_per_op, 1e9/r.ns_per_op, i + 1 == results.size() ? "" : ",");
+    }
+    std::printf("  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+    for(int i {1}; i + 1 < argc; i += 2)
+    {
+        if(std::strcmp(argv[i], "--n") == 0)
+        {
+            opts.n = std::stoull(argv[i + 1]);
+        }
+        else if(std::strcmp(argv[i], "--repeats") == 0)
+        {
+            opts.repeats = std::stoi(argv[i + 1]);
+        }
+        else if(std::strcmp(argv[i], "--budget-ms") == 0)
+        {
+            opts.budget_ms = std::stod(argv[i + 1]);
+        }
+        else if(std::strcmp(argv[i], "--seed") == 0)
+        {
+            opts.seed = std::stoull(argv[i + 1]);
+        }
+        else if(std::strcmp(argv[i], "--filter") == 0)
+        {
+            opts.filter = argv[i + 1];
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: bench [--n N] [--repeats R] [--budget-ms MS] [--seed S] [--filter TEXT]\n");
+            return 2;
+        }
+    }
+#ifdef SSS_FRACTION_NO_LUT
+    const char* variant {"generic"};
+#else
+    const char* variant {"lut"};
+#endif
+    std::fprintf(stderr, "variant: %s\n", variant);
+
+    std::mt19937_64 rng {opts.seed};
+    bench_gcd(rng);
+    bench_farey();
+    bench_fixed(rng);
+    bench_rescale(rng);
+    bench_quantize(rng);
+    bench_fused(rng);
+    bench_lazy(rng);
+    bench_packed(rng);
+    bench_adaptive(rng);
+    bench_atomic<int>("int");
+    bench_atomic<long long>("long long");
+    bench_sort<int>("int", 30000, rng);
+    bench_sort<long long>("long long", 1000000000, rng);
+    bench_all<signed char>("signed char", rng);
+    bench_all<unsigned char>("unsigned char", rng);
+    bench_all<short>("short", rng);
+    bench_all<unsigned short>("unsigned short", rng);
+    bench_all<int>("int", rng);
+    bench_all<unsigned int>("unsigned int", rng);
+    bench_all<long>("long", rng);
+    bench_all<unsigned long>("unsigned long", rng);
+    bench_all<long long>("long long", rng);
+    bench_all<unsigned long long>("unsigned long long", rng);
+
+    if(sss::stats::enabled())
+    {
+        sss::stats::counters c {sss::stats::snapshot()};
+        std::fprintf(stderr, "reduce calls %llu, max relative error %g\n",
+            static_cast<unsigned long long>(c.reduce_calls), c.max_relative_error);
+        for(std::size_t i {0}; i < sss::stats::op_count; ++i)
+        {
+            std::fprintf(stderr, "operator%s calls %llu, approximated %llu, loop iterations %llu\n",
+                sss::stats::op_names[i], static_cast<unsigned long long>(c.calls[i]),
+                static_cast<unsigned long long>(c.checked_failures[i]),
+                static_cast<unsigned long long>(c.loop_iterations[i]));
+        }
+    }
+    print_json(variant);
+}
@@ -1,6 +1,9 @@
 
 #include "cia.hpp"
 
+#include <bit>
+#include <type_traits>
+
 namespace sss
 {
     namespace cia
@@ -80,5 +83,111 @@ namespace sss
 
             return a%b;
         }
+
+        // |base|^exp < 2^(w*exp) for a base of bit width w, so the bit widths decide most cases up front: the loop
+        // only checks each multiplication when the result is within a factor of 2^exp of the limit.
+        template<typename T> requires std::integral<T> && std::numeric_limits<T>::is_specialized
+        constexpr std::optional<T> checked_pow(const T& base, std::uint64_t exp) noexcept
+        {
+            std::make_unsigned_t<T> magnitude {static_cast<std::make_unsigned_t<T>>(base)};
+            if(base < 0)
+            {
+                magnitude = static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0) - magnitude);
+            }
+            std::uint64_t width {static_cast<std::uint64_t>(std::bit_width(magnitude))};
+            std::uint64_t digits {static_cast<std::uint64_t>(std::numeric_limits<T>::digits)};
+            if(exp == 0)
+            {
+                return T(1);
+            }
+            if(width <= 1)
+            {
+                return (base < 0 && exp % 2 == 0) ? T(1) : base;
+            }
+            if(exp > digits || (width - 1)*exp > digits)
+            {
+                return {};
+            }
+            bool checked {width*exp > digits};
+            T result {1};
+            T x {base};
+            for(;;)
+            {
+                if(exp % 2 == 1)
+                {
+                    if(!checked)
+                    {
+                        result = static_cast<T>(result*x);
+                    }
+                    else if(std::optional<T> y {checked_mul<T>(result, x)}; y.has_value())
+                    {
+                        result = y.value();
+                    }
+                    else
+                    {
+                        return {};
+                    }
+                }
+                exp /= 2;
+                if(exp == 0)
+                {
+                    return result;
+                }
+                if(!checked)
+                {
+                    x = static_cast<T>(x*x);
+                }
+                else if(std::optional<T> y {checked_mul<T>(x, x)}; y.has_value())
+                {
+                    x = y.value();
+                }
+                else
+                {
+                    return {};
+                }
+            }
+        }
+
+        // Newton's iteration from a power of two at or above the root decreases monotonically onto the floor of
+        // the root. An overflowing r^(k-1) is larger than x, so its quotient is 0.
+        template<typename T> requires std::integral<T> && std::numeric_limits<T>::is_specialized
+        constexpr std::optional<T> iroot(const T& x, std::uint64_t k) noexcept
+        {
+            if(k == 0 || (x < 0 && k % 2 == 0))
+            {
+                return {};
+            }
+            std::uint64_t magnitude {static_cast<std::make_unsigned_t<T>>(x)};
+            if(x < 0)
+            {
+                magnitude = static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0)
+                    - static_cast<std::make_unsigned_t<T>>(x));
+            }
+            std::uint64_t width {static_cast<std::uint64_t>(std::bit_width(magnitude))};
+            std::uint64_t r {magnitude};
+            if(k >= width)
+            {
+                r = magnitude == 0 ? 0 : 1;
+            }
+            else if(k > 1)
+            {
+                r = std::uint64_t(1) << ((width + k - 1)/k);
+                for(;;)
+                {
+                    std::optional<std::uint64_t> p {checked_pow<std::uint64_t>(r, k - 1)};
+                    std::uint64_t y {((k - 1)*r + (p.has_value() ? magnitude/p.value() : 0))/k};
+                    if(y >= r)
+                    {
+                        break;
+                    }
+                    r = y;
+                }
+            }
+            if(x < 0)
+            {
+                return static_cast<T>(std::make_unsigned_t<T>(0) - static_cast<std::make_unsigned_t<T>>(r));
+            }
+            return static_cast<T>(r);
+        }
     }
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <concepts>
+#include <cstdint>
 #include <limits>
 
 namespace sss
@@ -22,6 +23,13 @@ namespace sss
         
         template<typename T> requires std::integral<T> && std::numeric_limits<T>::is_specialized
         constexpr std::optional<T> checked_rem(const T& a, const T& b) noexcept;
+
+        template<typename T> requires std::integral<T> && std::numeric_limits<T>::is_specialized
+        constexpr std::optional<T> checked_pow(const T& base, std::uint64_t exp) noexcept;
+
+        // The k-th root rounded toward zero. Fails for k == 0 and for negative x with an even k.
+        template<typename T> requires std::integral<T> && std::numeric_limits<T>::is_specialized
+        constexpr std::optional<T> iroot(const T& x, std::uint64_t k) noexcept;
     }
 }
 
@@ -0,0 +1,317 @@
+#include "continued_fraction.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotients_view<T>::iterator::iterator(void) noexcept:
+        numer{0},
+        denom{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotients_view<T>::iterator::iterator(
+        partial_quotient_t<T> numer,
+        partial_quotient_t<T> denom
+    ) noexcept:
+        numer{numer},
+        denom{denom}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotient_t<T> partial_quotients_view<T>::iterator::operator*(void) const noexcept
+    {
+        return floor_div(this->numer, this->denom);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename partial_quotients_view<T>::iterator& partial_quotients_view<T>::iterator::operator++(
+        void
+    ) noexcept
+    {
+        partial_quotient_t<T> rem {
+            static_cast<partial_quotient_t<T>>(this->numer - floor_div(this->numer, this->denom)*this->denom)
+        };
+        this->numer = this->denom;
+        this->denom = rem;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename partial_quotients_view<T>::iterator partial_quotients_view<T>::iterator::operator++(
+        int
+    ) noexcept
+    {
+        iterator x {*this};
+        ++*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool partial_quotients_view<T>::iterator::operator==(const iterator& rhs) const noexcept
+    {
+        return this->numer == rhs.numer && this->denom == rhs.denom;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool partial_quotients_view<T>::iterator::operator==(std::default_sentinel_t) const noexcept
+    {
+        return this->denom == 0;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotients_view<T>::partial_quotients_view(void) noexcept:
+        x{0, 0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotients_view<T>::partial_quotients_view(fraction<T> x) noexcept:
+        x{x}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename partial_quotients_view<T>::iterator partial_quotients_view<T>::begin(void) const noexcept
+    {
+        return iterator{this->x.get_numer(), this->x.get_denom()};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::default_sentinel_t partial_quotients_view<T>::end(void) const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotient_t<T> partial_quotients_view<T>::floor_div(
+        partial_quotient_t<T> numer,
+        partial_quotient_t<T> denom
+    ) noexcept
+    {
+        partial_quotient_t<T> q {static_cast<partial_quotient_t<T>>(numer/denom)};
+        if(numer % denom != 0 && numer < 0)
+        {
+            --q;
+        }
+        return q;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr convergents_view<T>::iterator::iterator(void) noexcept:
+        numer{0},
+        denom{0},
+        p0{0},
+        q0{1},
+        p1{1},
+        q1{0},
+        max_denom{0},
+        done{true}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr convergents_view<T>::iterator::iterator(fraction<T> x, std::make_unsigned_t<T> max_denom) noexcept:
+        numer{x.get_numer()},
+        denom{x.get_denom()},
+        p0{0},
+        q0{1},
+        p1{1},
+        q1{0},
+        max_denom{max_denom},
+        done{false}
+    {
+        ++*this;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> convergents_view<T>::iterator::operator*(void) const noexcept
+    {
+        return fraction<T>{reduced, static_cast<T>(this->p1), static_cast<std::make_unsigned_t<T>>(this->q1)};
+    }
+    // Convergents never have a larger numerator or denominator than the fraction they converge to, so p and q
+    // always fit in T once they pass the bound check.
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename convergents_view<T>::iterator& convergents_view<T>::iterator::operator++(void) noexcept
+    {
+        if(this->denom == 0)
+        {
+            this->done = true;
+            return *this;
+        }
+        partial_quotient_t<T> a {*typename partial_quotients_view<T>::iterator{this->numer, this->denom}};
+        partial_quotient_t<T> q {static_cast<partial_quotient_t<T>>(a*this->q1 + this->q0)};
+        if(q > this->max_denom)
+        {
+            this->done = true;
+            return *this;
+        }
+        partial_quotient_t<T> p {static_cast<partial_quotient_t<T>>(a*this->p1 + this->p0)};
+        partial_quotient_t<T> rem {static_cast<partial_quotient_t<T>>(this->numer - a*this->denom)};
+        this->numer = this->denom;
+        this->denom = rem;
+        this->p0 = this->p1;
+        this->q0 = this->q1;
+        this->p1 = p;
+        this->q1 = q;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename convergents_view<T>::iterator convergents_view<T>::iterator::operator++(int) noexcept
+    {
+        iterator x {*this};
+        ++*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool convergents_view<T>::iterator::operator==(const iterator& rhs) const noexcept
+    {
+        if(this->done || rhs.done)
+        {
+            return this->done == rhs.done;
+        }
+        return this->numer == rhs.numer && this->denom == rhs.denom && this->p1 == rhs.p1 && this->q1 == rhs.q1;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool convergents_view<T>::iterator::operator==(std::default_sentinel_t) const noexcept
+    {
+        return this->done;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr convergents_view<T>::convergents_view(void) noexcept:
+        x{0, 0},
+        max_denom{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr convergents_view<T>::convergents_view(fraction<T> x, std::make_unsigned_t<T> max_denom) noexcept:
+        x{x},
+        max_denom{max_denom}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename convergents_view<T>::iterator convergents_view<T>::begin(void) const noexcept
+    {
+        return iterator{this->x, this->max_denom};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::default_sentinel_t convergents_view<T>::end(void) const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr partial_quotients_view<T> partial_quotients(const fraction<T>& x) noexcept
+    {
+        return partial_quotients_view<T>{x};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr convergents_view<T> convergents(const fraction<T>& x, std::make_unsigned_t<T> max_denom) noexcept
+    {
+        return convergents_view<T>{x, max_denom};
+    }
+
+    // Each complete quotient is (P + sqrt(d))/Q with integers P and Q that stay below 2*sqrt(d), so everything fits
+    // in twice the width of T. Once the bound stops the expansion, the answer is either the last convergent or the
+    // largest semiconvergent within the bound; the semiconvergent wins if its coefficient t is more than half the
+    // partial quotient, and at exactly half if the next complete quotient exceeds k/k0, which the continued fractions
+    // of both decide term by term.
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> sqrt(const fraction<T>& x, std::make_unsigned_t<T> max_denom) noexcept
+    {
+        using W = std::conditional_t<sizeof(T) <= 4, std::uint64_t, wide::uint128_t>;
+        if(x.is_nan() || x.get_numer() < 0 || max_denom == 0)
+        {
+            return fraction<T>{0, 0};
+        }
+        if(x.is_infinite())
+        {
+            return x;
+        }
+        if(std::optional<fraction<T>> r {x.nth_root(2)}; r.has_value() && r.value().get_denom() <= max_denom)
+        {
+            return r.value();
+        }
+
+        W d {W(static_cast<std::make_unsigned_t<T>>(x.get_numer()))*W(x.get_denom())};
+        W s {static_cast<W>(wide::isqrt(d))};
+        auto greater = [d, s](W P, W Q, W u, W v) -> bool
+        {
+            for(bool larger {true};; larger = !larger)
+            {
+                if(Q == 0)
+                {
+                    return larger;
+                }
+                if(v == 0)
+                {
+                    return !larger;
+                }
+                W a {(P + s)/Q};
+                W c {u/v};
+                if(a != c)
+                {
+                    return (a > c) == larger;
+                }
+                W r {u - c*v};
+                if(r == 0)
+                {
+                    return larger;
+                }
+                P = a*Q - P;
+                Q = (d - P*P)/Q;
+                u = v;
+                v = r;
+            }
+        };
+
+        W max_numer {W(std::numeric_limits<T>::max())};
+        W P {0};
+        W Q {W(x.get_denom())};
+        W h0 {0};
+        W k0 {1};
+        W h1 {1};
+        W k1 {0};
+        for(;;)
+        {
+            W a {(P + s)/Q};
+            W t {a};
+            if(h1 != 0)
+            {
+                t = std::min(t, W((max_numer - h0)/h1));
+            }
+            if(k1 != 0)
+            {
+                t = std::min(t, W((W(max_denom) - k0)/k1));
+            }
+            W next_P {a*Q - P};
+            W next_Q {(d - next_P*next_P)/Q};
+            if(t < a)
+            {
+                if(k1 == 0 || 2*t > a || (2*t == a && greater(next_P, next_Q, k1, k0)))
+                {
+                    return fraction<T>{
+                        reduced,
+                        static_cast<T>(t*h1 + h0),
+                        static_cast<std::make_unsigned_t<T>>(t*k1 + k0)
+                    };
+                }
+                return fraction<T>{reduced, static_cast<T>(h1), static_cast<std::make_unsigned_t<T>>(k1)};
+            }
+            W h {a*h1 + h0};
+            W k {a*k1 + k0};
+            h0 = h1;
+            k0 = k1;
+            h1 = h;
+            k1 = k;
+            if(next_Q == 0)
+            {
+                return fraction<T>{reduced, static_cast<T>(h1), static_cast<std::make_unsigned_t<T>>(k1)};
+            }
+            P = next_P;
+            Q = next_Q;
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // Partial quotients can exceed T (1/255 in unsigned char is [0; 255]) and the first one is negative for negative
+    // values, so they are produced in the next wider signed type.
+    template<typename T> requires nonbool_integral<T>
+    using partial_quotient_t = wide::wider_t<std::make_signed_t<T>>;
+
+    // The regular continued fraction [a0; a1, a2, ...] of a finite fraction, computed lazily by Euclid's algorithm.
+    // a0 is floor(x) and every later term is positive. Infinities and NaN have no terms.
+    template<typename T> requires nonbool_integral<T>
+    class partial_quotients_view : public std::ranges::view_interface<partial_quotients_view<T>>
+    {
+        public:
+            class iterator
+            {
+                private:
+                    partial_quotient_t<T> numer;
+                    partial_quotient_t<T> denom;
+
+                public:
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = partial_quotient_t<T>;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator(void) noexcept;
+                    constexpr iterator(partial_quotient_t<T> numer, partial_quotient_t<T> denom) noexcept;
+
+                    [[nodiscard]] constexpr partial_quotient_t<T> operator*(void) const noexcept;
+                    constexpr iterator& operator++(void) noexcept;
+                    constexpr iterator operator++(int) noexcept;
+                    [[nodiscard]] constexpr bool operator==(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept;
+            };
+
+        private:
+            fraction<T> x;
+
+        public:
+            constexpr partial_quotients_view(void) noexcept;
+            constexpr explicit partial_quotients_view(fraction<T> x) noexcept;
+
+            [[nodiscard]] constexpr iterator begin(void) const noexcept;
+            [[nodiscard]] constexpr std::default_sentinel_t end(void) const noexcept;
+
+        private:
+            [[nodiscard]] static constexpr partial_quotient_t<T> floor_div(
+                partial_quotient_t<T> numer,
+                partial_quotient_t<T> denom
+            ) noexcept;
+    };
+
+    // The convergents p0/q0, p1/q1, ... of a finite fraction, ending with the fraction itself. Each one is closer to
+    // the fraction than the one before. Iteration stops before the first convergent whose denominator exceeds
+    // `max_denom`, so the last convergent produced is the closest convergent within the bound. A semiconvergent
+    // within the bound can be closer still; sqrt() below checks for one.
+    template<typename T> requires nonbool_integral<T>
+    class convergents_view : public std::ranges::view_interface<convergents_view<T>>
+    {
+        public:
+            class iterator
+            {
+                private:
+                    partial_quotient_t<T> numer;
+                    partial_quotient_t<T> denom;
+                    partial_quotient_t<T> p0;
+                    partial_quotient_t<T> q0;
+                    partial_quotient_t<T> p1;
+                    partial_quotient_t<T> q1;
+                    partial_quotient_t<T> max_denom;
+                    bool done;
+
+                public:
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = fraction<T>;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator(void) noexcept;
+                    constexpr iterator(fraction<T> x, std::make_unsigned_t<T> max_denom) noexcept;
+
+                    [[nodiscard]] constexpr fraction<T> operator*(void) const noexcept;
+                    constexpr iterator& operator++(void) noexcept;
+                    constexpr iterator operator++(int) noexcept;
+                    [[nodiscard]] constexpr bool operator==(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept;
+            };
+
+        private:
+            fraction<T> x;
+            std::make_unsigned_t<T> max_denom;
+
+        public:
+            constexpr convergents_view(void) noexcept;
+            constexpr explicit convergents_view(
+                fraction<T> x,
+                std::make_unsigned_t<T> max_denom = std::numeric_limits<std::make_unsigned_t<T>>::max()
+            ) noexcept;
+
+            [[nodiscard]] constexpr iterator begin(void) const noexcept;
+            [[nodiscard]] constexpr std::default_sentinel_t end(void) const noexcept;
+    };
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr partial_quotients_view<T> partial_quotients(const fraction<T>& x) noexcept;
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr convergents_view<T> convergents(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> max_denom = std::numeric_limits<std::make_unsigned_t<T>>::max()
+    ) noexcept;
+
+    // The fraction closest to the square root of x among those with a denominator no larger than `max_denom`, which
+    // is the exact root when there is one within the bound. Only integer arithmetic is used: the continued fraction
+    // of sqrt(p/q) = sqrt(pq)/q is generated from the quadratic surd. Negative values and NaN give NaN.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr fraction<T> sqrt(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> max_denom = std::numeric_limits<std::make_unsigned_t<T>>::max()
+    ) noexcept;
+}
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sss::partial_quotients_view<T>> = true;
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sss::convergents_view<T>> = true;
+
+#include "continued_fraction.cpp"
@@ -0,0 +1,323 @@
+#include "farey.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_view<T>::iterator::iterator(void) noexcept:
+        a{0},
+        b{0},
+        c{0},
+        d{0},
+        n{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_view<T>::iterator::iterator(T n) noexcept:
+        a{0},
+        b{1},
+        c{1},
+        d{static_cast<farey_wide_t<T>>(n)},
+        n{static_cast<farey_wide_t<T>>(n)}
+    {
+        if(n < 1)
+        {
+            *this = iterator{};
+        }
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> farey_view<T>::iterator::operator*(void) const noexcept
+    {
+        return fraction<T>{reduced, static_cast<T>(this->a), static_cast<std::make_unsigned_t<T>>(this->b)};
+    }
+    // Neighbours a/b < c/d in the sequence satisfy bc - ad = 1, and the term after them is the mediant of a/b with
+    // the largest multiple of c/d that keeps the denominator within the order.
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename farey_view<T>::iterator& farey_view<T>::iterator::operator++(void) noexcept
+    {
+        if(this->a == this->b)
+        {
+            *this = iterator{};
+            return *this;
+        }
+        farey_wide_t<T> k {(this->n + this->b)/this->d};
+        farey_wide_t<T> e {k*this->c - this->a};
+        farey_wide_t<T> f {k*this->d - this->b};
+        this->a = this->c;
+        this->b = this->d;
+        this->c = e;
+        this->d = f;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename farey_view<T>::iterator farey_view<T>::iterator::operator++(int) noexcept
+    {
+        iterator x {*this};
+        ++*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool farey_view<T>::iterator::operator==(const iterator& rhs) const noexcept
+    {
+        return this->a == rhs.a && this->b == rhs.b && this->c == rhs.c && this->d == rhs.d && this->n == rhs.n;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool farey_view<T>::iterator::operator==(std::default_sentinel_t) const noexcept
+    {
+        return this->b == 0;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_view<T>::farey_view(void) noexcept:
+        n{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_view<T>::farey_view(T n) noexcept:
+        n{n}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename farey_view<T>::iterator farey_view<T>::begin(void) const noexcept
+    {
+        return iterator{this->n};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::default_sentinel_t farey_view<T>::end(void) const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr stern_brocot_view<T>::iterator::iterator(void) noexcept:
+        negative{false},
+        lower_numer{0},
+        lower_denom{0},
+        upper_numer{0},
+        upper_denom{0},
+        left_numer{0},
+        left_denom{1},
+        right_numer{1},
+        right_denom{0},
+        done{true}
+    {
+
+    }
+    // Starting from 0/1 and 0/0 instead of 0/1 and 1/0 makes the first node 0/1 rather than 1/1, which is how an
+    // interval containing 0 ends immediately.
+    template<typename T> requires nonbool_integral<T>
+    constexpr stern_brocot_view<T>::iterator::iterator(const stern_brocot_view& view) noexcept:
+        negative{view.negative},
+        lower_numer{view.lower_numer},
+        lower_denom{view.lower_denom},
+        upper_numer{view.upper_numer},
+        upper_denom{view.upper_denom},
+        left_numer{0},
+        left_denom{1},
+        right_numer{view.lower_numer == 0 ? farey_wide_t<T>{0} : farey_wide_t<T>{1}},
+        right_denom{0},
+        done{view.lower_denom == 0}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> stern_brocot_view<T>::iterator::operator*(void) const noexcept
+    {
+        return to_fraction(this->negative, this->left_numer + this->right_numer, this->left_denom + this->right_denom);
+    }
+    // Every node visited is an ancestor of the simplest fraction in the interval, so its numerator and denominator
+    // are no larger than those of either bound and the products below fit.
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename stern_brocot_view<T>::iterator& stern_brocot_view<T>::iterator::operator++(void) noexcept
+    {
+        farey_wide_t<T> numer {this->left_numer + this->right_numer};
+        farey_wide_t<T> denom {this->left_denom + this->right_denom};
+        if(numer*this->lower_denom < this->lower_numer*denom)
+        {
+            this->left_numer = numer;
+            this->left_denom = denom;
+        }
+        else if(numer*this->upper_denom > this->upper_numer*denom)
+        {
+            this->right_numer = numer;
+            this->right_denom = denom;
+        }
+        else
+        {
+            this->done = true;
+        }
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename stern_brocot_view<T>::iterator stern_brocot_view<T>::iterator::operator++(int) noexcept
+    {
+        iterator x {*this};
+        ++*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool stern_brocot_view<T>::iterator::operator==(const iterator& rhs) const noexcept
+    {
+        if(this->done || rhs.done)
+        {
+            return this->done == rhs.done;
+        }
+        return this->left_numer == rhs.left_numer && this->left_denom == rhs.left_denom
+            && this->right_numer == rhs.right_numer && this->right_denom == rhs.right_denom;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool stern_brocot_view<T>::iterator::operator==(std::default_sentinel_t) const noexcept
+    {
+        return this->done;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr stern_brocot_view<T>::stern_brocot_view(void) noexcept:
+        negative{false},
+        lower_numer{0},
+        lower_denom{0},
+        upper_numer{0},
+        upper_denom{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr stern_brocot_view<T>::stern_brocot_view(fraction<T> lower, fraction<T> upper) noexcept:
+        stern_brocot_view{}
+    {
+        if(lower.is_nan() || upper.is_nan())
+        {
+            return;
+        }
+        if(lower.get_numer() <= 0 && upper.get_numer() >= 0)
+        {
+            this->lower_numer = 0;
+            this->lower_denom = 1;
+            this->upper_numer = magnitude(upper.get_numer());
+            this->upper_denom = upper.get_denom();
+            return;
+        }
+        if(lower.get_numer() > 0 && upper.get_numer() > 0)
+        {
+            this->lower_numer = magnitude(lower.get_numer());
+            this->lower_denom = lower.get_denom();
+            this->upper_numer = magnitude(upper.get_numer());
+            this->upper_denom = upper.get_denom();
+        }
+        else if(lower.get_numer() < 0 && upper.get_numer() < 0)
+        {
+            this->negative = true;
+            this->lower_numer = magnitude(upper.get_numer());
+            this->lower_denom = upper.get_denom();
+            this->upper_numer = magnitude(lower.get_numer());
+            this->upper_denom = lower.get_denom();
+        }
+        if(this->lower_denom == 0 || this->lower_numer*this->upper_denom > this->upper_numer*this->lower_denom)
+        {
+            *this = stern_brocot_view{};
+        }
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename stern_brocot_view<T>::iterator stern_brocot_view<T>::begin(void) const noexcept
+    {
+        return iterator{*this};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::default_sentinel_t stern_brocot_view<T>::end(void) const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    // A run of steps in one direction is a partial quotient, so this is Euclid's algorithm on both bounds at once:
+    // while they share their integer part a, the answer is a + 1/r with r the simplest fraction between the
+    // reciprocals of their fractional parts. It stops at the first integer inside the interval.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<fraction<T>> stern_brocot_view<T>::simplest(void) const noexcept
+    {
+        if(this->lower_denom == 0)
+        {
+            return std::nullopt;
+        }
+        farey_wide_t<T> lower_numer {this->lower_numer};
+        farey_wide_t<T> lower_denom {this->lower_denom};
+        farey_wide_t<T> upper_numer {this->upper_numer};
+        farey_wide_t<T> upper_denom {this->upper_denom};
+        farey_wide_t<T> h0 {0};
+        farey_wide_t<T> k0 {1};
+        farey_wide_t<T> h1 {1};
+        farey_wide_t<T> k1 {0};
+        for(;;)
+        {
+            farey_wide_t<T> a {lower_numer/lower_denom};
+            farey_wide_t<T> rem {lower_numer - a*lower_denom};
+            if(rem == 0 || (a + 1)*upper_denom <= upper_numer)
+            {
+                if(rem != 0)
+                {
+                    ++a;
+                }
+                return to_fraction(this->negative, a*h1 + h0, a*k1 + k0);
+            }
+            farey_wide_t<T> h {a*h1 + h0};
+            farey_wide_t<T> k {a*k1 + k0};
+            h0 = h1;
+            k0 = k1;
+            h1 = h;
+            k1 = k;
+            farey_wide_t<T> next_numer {upper_denom};
+            farey_wide_t<T> next_denom {upper_numer - a*upper_denom};
+            upper_numer = lower_denom;
+            upper_denom = rem;
+            lower_numer = next_numer;
+            lower_denom = next_denom;
+        }
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_wide_t<T> stern_brocot_view<T>::magnitude(T x) noexcept
+    {
+        if constexpr(std::is_signed_v<T>)
+        {
+            if(x < 0)
+            {
+                return farey_wide_t<T>{0} - static_cast<farey_wide_t<T>>(x);
+            }
+        }
+        return static_cast<farey_wide_t<T>>(x);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> stern_brocot_view<T>::to_fraction(
+        bool negative,
+        farey_wide_t<T> numer,
+        farey_wide_t<T> denom
+    ) noexcept
+    {
+        if(negative)
+        {
+            numer = farey_wide_t<T>{0} - numer;
+        }
+        return fraction<T>{reduced, static_cast<T>(numer), static_cast<std::make_unsigned_t<T>>(denom)};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr farey_view<T> farey(T n) noexcept
+    {
+        return farey_view<T>{n};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr stern_brocot_view<T> stern_brocot(const fraction<T>& lower, const fraction<T>& upper) noexcept
+    {
+        return stern_brocot_view<T>{lower, upper};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<fraction<T>> simplest_between(const fraction<T>& lower, const fraction<T>& upper) noexcept
+    {
+        return stern_brocot_view<T>{lower, upper}.simplest();
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // At least 32 bits and twice the width of T, so that a product of two numerators or denominators always fits and
+    // arithmetic on it is never promoted to int.
+    template<typename T> requires nonbool_integral<T>
+    using farey_wide_t = std::conditional_t<
+        sizeof(T) == 1,
+        std::uint32_t,
+        wide::wider_t<std::make_unsigned_t<T>>
+    >;
+
+    // The Farey sequence of order n: every reduced fraction in [0, 1] with a denominator no larger than n, in
+    // ascending order from 0/1 to 1/1. Each term follows from the previous two, so there is no gcd, no sort and no
+    // storage. The order has type T because every numerator up to n must be representable; a negative order gives
+    // an empty sequence.
+    template<typename T> requires nonbool_integral<T>
+    class farey_view : public std::ranges::view_interface<farey_view<T>>
+    {
+        public:
+            class iterator
+            {
+                private:
+                    farey_wide_t<T> a;
+                    farey_wide_t<T> b;
+                    farey_wide_t<T> c;
+                    farey_wide_t<T> d;
+                    farey_wide_t<T> n;
+
+                public:
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = fraction<T>;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator(void) noexcept;
+                    constexpr explicit iterator(T n) noexcept;
+
+                    [[nodiscard]] constexpr fraction<T> operator*(void) const noexcept;
+                    constexpr iterator& operator++(void) noexcept;
+                    constexpr iterator operator++(int) noexcept;
+                    [[nodiscard]] constexpr bool operator==(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept;
+            };
+
+        private:
+            T n;
+
+        public:
+            constexpr farey_view(void) noexcept;
+            constexpr explicit farey_view(T n) noexcept;
+
+            [[nodiscard]] constexpr iterator begin(void) const noexcept;
+            [[nodiscard]] constexpr std::default_sentinel_t end(void) const noexcept;
+    };
+
+    // The nodes of the Stern–Brocot tree visited by a binary search for the closed interval [lower, upper], starting
+    // at 1/1 and ending with the first node inside the interval, which is its simplest fraction: the one with the
+    // smallest denominator, and the smallest numerator among those. Every node is produced, so a long run of left
+    // or right steps takes as many increments as it has nodes; simplest() skips whole runs at once. Negative
+    // intervals search the mirrored tree, an interval containing 0 gives just 0, and an empty interval, a NaN
+    // bound or a lower bound of infinity gives nothing.
+    template<typename T> requires nonbool_integral<T>
+    class stern_brocot_view : public std::ranges::view_interface<stern_brocot_view<T>>
+    {
+        public:
+            class iterator
+            {
+                private:
+                    bool negative;
+                    farey_wide_t<T> lower_numer;
+                    farey_wide_t<T> lower_denom;
+                    farey_wide_t<T> upper_numer;
+                    farey_wide_t<T> upper_denom;
+                    farey_wide_t<T> left_numer;
+                    farey_wide_t<T> left_denom;
+                    farey_wide_t<T> right_numer;
+                    farey_wide_t<T> right_denom;
+                    bool done;
+
+                public:
+                    using iterator_concept = std::forward_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = fraction<T>;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator(void) noexcept;
+                    constexpr iterator(const stern_brocot_view& view) noexcept;
+
+                    [[nodiscard]] constexpr fraction<T> operator*(void) const noexcept;
+                    constexpr iterator& operator++(void) noexcept;
+                    constexpr iterator operator++(int) noexcept;
+                    [[nodiscard]] constexpr bool operator==(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept;
+            };
+
+        private:
+            // The interval as magnitudes, with the sign split off. A lower denominator of 0 marks an empty search.
+            bool negative;
+            farey_wide_t<T> lower_numer;
+            farey_wide_t<T> lower_denom;
+            farey_wide_t<T> upper_numer;
+            farey_wide_t<T> upper_denom;
+
+        public:
+            constexpr stern_brocot_view(void) noexcept;
+            constexpr stern_brocot_view(fraction<T> lower, fraction<T> upper) noexcept;
+
+            [[nodiscard]] constexpr iterator begin(void) const noexcept;
+            [[nodiscard]] constexpr std::default_sentinel_t end(void) const noexcept;
+            // The last node, found with one division per run of equal steps (the partial quotients of the bounds).
+            [[nodiscard]] constexpr std::optional<fraction<T>> simplest(void) const noexcept;
+
+        private:
+            [[nodiscard]] static constexpr farey_wide_t<T> magnitude(T x) noexcept;
+            [[nodiscard]] static constexpr fraction<T> to_fraction(
+                bool negative,
+                farey_wide_t<T> numer,
+                farey_wide_t<T> denom
+            ) noexcept;
+    };
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr farey_view<T> farey(T n) noexcept;
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr stern_brocot_view<T> stern_brocot(
+        const fraction<T>& lower,
+        const fraction<T>& upper
+    ) noexcept;
+
+    // The simplest fraction in [lower, upper], or nothing if the interval holds no finite fraction.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr std::optional<fraction<T>> simplest_between(
+        const fraction<T>& lower,
+        const fraction<T>& upper
+    ) noexcept;
+}
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sss::farey_view<T>> = true;
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sss::stern_brocot_view<T>> = true;
+
+#include "farey.cpp"
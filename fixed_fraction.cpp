@@ -0,0 +1,145 @@
+#include "fixed_fraction.hpp"
+
+namespace sss
+{
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom>::fixed_fraction(void) noexcept:
+        ticks{0}
+    {
+
+    }
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> fixed_fraction<T, Denom>::from_ticks(T ticks) noexcept
+    {
+        fixed_fraction x {};
+        x.ticks = ticks;
+        return x;
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr std::optional<fixed_fraction<T, Denom>> fixed_fraction<T, Denom>::from_fraction(
+        const fraction<T>& x
+    ) noexcept
+    {
+        using W = wide::wider_t<T>;
+        if(!x.is_finite())
+        {
+            return std::nullopt;
+        }
+        W scaled {static_cast<W>(W{x.get_numer()}*W{Denom})};
+        if(scaled % W{x.get_denom()} != 0)
+        {
+            return std::nullopt;
+        }
+        W ticks {static_cast<W>(scaled/W{x.get_denom()})};
+        if(ticks < W{std::numeric_limits<T>::min()} || ticks > W{std::numeric_limits<T>::max()})
+        {
+            return std::nullopt;
+        }
+        return from_ticks(static_cast<T>(ticks));
+    }
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr T fixed_fraction<T, Denom>::get_ticks(void) const noexcept
+    {
+        return this->ticks;
+    }
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom>::operator fraction<T>(void) const noexcept
+    {
+        return fraction<T>{this->ticks, Denom};
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    template<typename F> requires std::floating_point<F>
+    constexpr fixed_fraction<T, Denom>::operator F(void) const noexcept
+    {
+        return static_cast<F>(this->ticks)/static_cast<F>(Denom);
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    template<std::make_unsigned_t<T> D> requires (D % Denom == 0)
+    constexpr fixed_fraction<T, Denom>::operator fixed_fraction<T, D>(void) const noexcept
+    {
+        return fixed_fraction<T, D>::from_ticks(static_cast<T>(this->ticks*static_cast<T>(D/Denom)));
+    }
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> fixed_fraction<T, Denom>::operator+(const fixed_fraction& rhs) const noexcept
+    {
+        return from_ticks(static_cast<T>(this->ticks + rhs.ticks));
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> fixed_fraction<T, Denom>::operator-(const fixed_fraction& rhs) const noexcept
+    {
+        return from_ticks(static_cast<T>(this->ticks - rhs.ticks));
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> fixed_fraction<T, Denom>::operator*(const T& rhs) const noexcept
+    {
+        return from_ticks(static_cast<T>(this->ticks*rhs));
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom>& fixed_fraction<T, Denom>::operator+=(const fixed_fraction& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom>& fixed_fraction<T, Denom>::operator-=(const fixed_fraction& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom>& fixed_fraction<T, Denom>::operator*=(const T& rhs) noexcept
+    {
+        return *this = *this*rhs;
+    }
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> fixed_fraction<T, Denom>::operator-(void) const noexcept
+        requires std::is_signed_v<T>
+    {
+        return from_ticks(static_cast<T>(-this->ticks));
+    }
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    constexpr fixed_fraction<T, Denom> operator*(const T& lhs, const fixed_fraction<T, Denom>& rhs) noexcept
+    {
+        return rhs*lhs;
+    }
+
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    constexpr fixed_fraction<T, common_timebase_v<T, A, B>> operator+(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept
+    {
+        using common = fixed_fraction<T, common_timebase_v<T, A, B>>;
+        return static_cast<common>(lhs) + static_cast<common>(rhs);
+    }
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    constexpr fixed_fraction<T, common_timebase_v<T, A, B>> operator-(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept
+    {
+        using common = fixed_fraction<T, common_timebase_v<T, A, B>>;
+        return static_cast<common>(lhs) - static_cast<common>(rhs);
+    }
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    constexpr bool operator==(const fixed_fraction<T, A>& lhs, const fixed_fraction<T, B>& rhs) noexcept
+    {
+        return (lhs <=> rhs) == 0;
+    }
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    constexpr std::strong_ordering operator<=>(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept
+    {
+        using W = wide::wider_t<T>;
+        return W{lhs.get_ticks()}*W{B} <=> W{rhs.get_ticks()}*W{A};
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // A count of 1/Denom ticks, such as samples at 48000 Hz. The denominator is part of the type, so a value is a
+    // single T, arithmetic within one timebase is plain integer arithmetic with no reduce(), and overflow behaves as
+    // it does for T. Values in different timebases combine in their least common timebase, which is computed at
+    // compile time and must fit in the unsigned counterpart of T.
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    class fixed_fraction
+    {
+        private:
+            T ticks;
+
+        public:
+            static constexpr std::make_unsigned_t<T> denom {Denom};
+
+            constexpr fixed_fraction(void) noexcept;
+
+            [[nodiscard]] static constexpr fixed_fraction from_ticks(T ticks) noexcept;
+            // The same value in this timebase, or nothing when it is not a whole number of ticks, does not fit in T,
+            // or is not finite.
+            [[nodiscard]] static constexpr std::optional<fixed_fraction> from_fraction(const fraction<T>& x) noexcept;
+
+            [[nodiscard]] constexpr T get_ticks(void) const noexcept;
+
+            [[nodiscard]] constexpr explicit operator fraction<T>(void) const noexcept;
+            template<typename F> requires std::floating_point<F>
+            [[nodiscard]] constexpr explicit operator F(void) const noexcept;
+            // The same value in a finer timebase; exact, as long as the tick count fits in T.
+            template<std::make_unsigned_t<T> D> requires (D % Denom == 0)
+            [[nodiscard]] constexpr explicit operator fixed_fraction<T, D>(void) const noexcept;
+
+            [[nodiscard]] constexpr fixed_fraction operator+(const fixed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr fixed_fraction operator-(const fixed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr fixed_fraction operator*(const T& rhs) const noexcept;
+            constexpr fixed_fraction& operator+=(const fixed_fraction& rhs) noexcept;
+            constexpr fixed_fraction& operator-=(const fixed_fraction& rhs) noexcept;
+            constexpr fixed_fraction& operator*=(const T& rhs) noexcept;
+            [[nodiscard]] constexpr fixed_fraction operator-(void) const noexcept requires std::is_signed_v<T>;
+            [[nodiscard]] constexpr bool operator==(const fixed_fraction& rhs) const noexcept = default;
+            [[nodiscard]] constexpr std::strong_ordering operator<=>(
+                const fixed_fraction& rhs
+            ) const noexcept = default;
+    };
+
+    template<typename T, std::make_unsigned_t<T> Denom> requires nonbool_integral<T> && (Denom != 0)
+    [[nodiscard]] constexpr fixed_fraction<T, Denom> operator*(
+        const T& lhs,
+        const fixed_fraction<T, Denom>& rhs
+    ) noexcept;
+
+    // The least common multiple of two timebases, which every value of either is a whole number of ticks of.
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B> requires nonbool_integral<T>
+    inline constexpr std::make_unsigned_t<T> common_timebase_v {[]()
+    {
+        constexpr std::make_unsigned_t<T> a {static_cast<std::make_unsigned_t<T>>(A/std::gcd(A, B))};
+        static_assert(a <= std::numeric_limits<std::make_unsigned_t<T>>::max()/B, "the common timebase overflows");
+        return static_cast<std::make_unsigned_t<T>>(a*B);
+    }()};
+
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    [[nodiscard]] constexpr fixed_fraction<T, common_timebase_v<T, A, B>> operator+(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept;
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    [[nodiscard]] constexpr fixed_fraction<T, common_timebase_v<T, A, B>> operator-(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept;
+    // Cross-multiplied in twice the width of T, so any two timebases compare exactly, even when their common
+    // timebase would not fit.
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    [[nodiscard]] constexpr bool operator==(const fixed_fraction<T, A>& lhs, const fixed_fraction<T, B>& rhs) noexcept;
+    template<typename T, std::make_unsigned_t<T> A, std::make_unsigned_t<T> B>
+        requires nonbool_integral<T> && (A != B)
+    [[nodiscard]] constexpr std::strong_ordering operator<=>(
+        const fixed_fraction<T, A>& lhs,
+        const fixed_fraction<T, B>& rhs
+    ) noexcept;
+}
+
+#include "fixed_fraction.cpp"
@@ -3,7 +3,16 @@
 #include <algorithm>
 #include <format>
 #include <bit>
+#include <utility>
 #include "cia.hpp"
+#include "lut.hpp"
+#include "stats.hpp"
+#include "status.hpp"
+// wide.hpp is built on __int128; without it the widened 8- and 16-bit paths are left out and those operators take the
+// checked path like every other width.
+#ifdef __SIZEOF_INT128__
+#include "wide.hpp"
+#endif
 
 namespace sss
 {
@@ -25,6 +34,13 @@ namespace sss
         fraction{0, 1}
     {
 
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T>::fraction(reduced_t, T numer, std::make_unsigned_t<T> denom) noexcept:
+        numer{numer},
+        denom{denom}
+    {
+        
     }
 
     template<typename T> requires nonbool_integral<T>
@@ -159,33 +175,100 @@ namespace sss
         }
         return {static_cast<T>(this->numer % static_cast<T>(this->denom)), this->denom};
     }
+    // Powers of coprime integers are coprime, so raising the numerator and denominator separately gives a reduced
+    // result without any gcd. Only when one of them overflows does this fall back to approximating multiplication.
     template<typename T> requires nonbool_integral<T>
     template<typename I> requires nonbool_integral<I>
     constexpr fraction<T> fraction<T>::pow(const I& rhs) const noexcept
     {
-        I n {rhs};
-        fraction r {1};
-        fraction x {n < 0 ? this->recip() : *this};
-
-        if(n & 1 == 1)
+        std::uint64_t n {static_cast<std::make_unsigned_t<I>>(rhs)};
+        if(rhs < 0)
+        {
+            n = static_cast<std::make_unsigned_t<I>>(
+                std::make_unsigned_t<I>(0) - static_cast<std::make_unsigned_t<I>>(rhs)
+            );
+        }
+        std::make_unsigned_t<T> a {magnitude(this->numer)};
+        std::make_unsigned_t<T> b {this->denom};
+        if(rhs < 0)
         {
-            r = x;
+            std::swap(a, b);
+        }
+        std::optional<std::make_unsigned_t<T>> numer {cia::checked_pow(a, n)};
+        std::optional<std::make_unsigned_t<T>> denom {cia::checked_pow(b, n)};
+        bool negative {this->numer < 0 && n % 2 == 1};
+        if(
+            numer.has_value() && denom.has_value()
+            && numer.value() <= magnitude(std::numeric_limits<T>::max()) + std::make_unsigned_t<T>(negative)
+        )
+        {
+            T x {static_cast<T>(negative
+                ? static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0) - numer.value())
+                : numer.value())};
+            if(x == 0 || denom.value() == 0)
+            {
+                return {x, denom.value()};
+            }
+            return {reduced, x, denom.value()};
         }
 
+        fraction r {1};
+        fraction x {rhs < 0 ? this->recip() : *this};
         for(;;)
         {
-            n = n >> 1;
+            if(n % 2 == 1)
+            {
+                r *= x;
+            }
+            n /= 2;
             if(n == 0)
             {
                 return r;
             }
             x *= x;
-            if(n & 1 == 1)
-            {
-                r *= x;
-            }
         }
     }
+    template<typename T> requires nonbool_integral<T>
+    template<typename I> requires nonbool_integral<I>
+    constexpr std::optional<fraction<T>> fraction<T>::nth_root(const I& k) const noexcept
+    {
+        std::uint64_t n {static_cast<std::make_unsigned_t<I>>(k)};
+        if(k < 0)
+        {
+            n = static_cast<std::make_unsigned_t<I>>(
+                std::make_unsigned_t<I>(0) - static_cast<std::make_unsigned_t<I>>(k)
+            );
+        }
+        std::make_unsigned_t<T> a {magnitude(this->numer)};
+        std::make_unsigned_t<T> b {this->denom};
+        if(k < 0)
+        {
+            std::swap(a, b);
+        }
+        bool negative {this->numer < 0};
+        if(negative && n % 2 == 0)
+        {
+            return std::nullopt;
+        }
+        std::optional<std::make_unsigned_t<T>> numer {cia::iroot(a, n)};
+        std::optional<std::make_unsigned_t<T>> denom {cia::iroot(b, n)};
+        if(
+            !numer.has_value() || !denom.has_value()
+            || cia::checked_pow(numer.value(), n) != a || cia::checked_pow(denom.value(), n) != b
+            || numer.value() > magnitude(std::numeric_limits<T>::max()) + std::make_unsigned_t<T>(negative)
+        )
+        {
+            return std::nullopt;
+        }
+        T x {static_cast<T>(negative
+            ? static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0) - numer.value())
+            : numer.value())};
+        if(x == 0 || denom.value() == 0)
+        {
+            return fraction{x, denom.value()};
+        }
+        return fraction{reduced, x, denom.value()};
+    }
 
     template<typename T> requires nonbool_integral<T>
     template<typename I> requires nonbool_integral<I>
@@ -215,7 +298,11 @@ namespace sss
                 && x.denom <= static_cast<std::make_unsigned_t<T>>(std::numeric_limits<std::make_unsigned_t<I>>::max())
             )
             {
-                return fraction<I>{static_cast<I>(this->numer), static_cast<std::make_unsigned_t<I>>(this->denom)};
+                if(i != 1)
+                {
+                    raise_inexact();
+                }
+                return fraction<I>{static_cast<I>(x.numer), static_cast<std::make_unsigned_t<I>>(x.denom)};
             }
             x = {
                 static_cast<T>(this->numer/++i),
@@ -253,6 +340,7 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr fraction<T> fraction<T>::operator+(const fraction<T> rhs) const noexcept
     {
+        stats::count_call(stats::op::add);
         fraction<T> a {*this};
         fraction<T> b {rhs};
         for(T i {1}, j {1};;)
@@ -260,6 +348,12 @@ namespace sss
             std::optional<fraction<T>> y = a.checked_add(b);
             if(y.has_value())
             {
+                if(i != 1 || j != 1)
+                {
+                    raise_inexact();
+                }
+                stats::count_approximation(stats::op::add, std::uint64_t(i - 1) + std::uint64_t(j - 1), *this, rhs,
+                    y.value());
                 return y.value();
             }
             std::make_unsigned_t<T> a_numer = static_cast<std::make_unsigned_t<T>>(a.numer < 0 ? -1 - a.numer : a.numer)
@@ -288,6 +382,7 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr fraction<T> fraction<T>::operator-(const fraction<T> rhs) const noexcept
     {
+        stats::count_call(stats::op::sub);
         fraction<T> a {*this};
         fraction<T> b {rhs};
         for(T i {1}, j {1};;)
@@ -295,6 +390,12 @@ namespace sss
             std::optional<fraction<T>> y = a.checked_sub(b);
             if(y.has_value())
             {
+                if(i != 1 || j != 1)
+                {
+                    raise_inexact();
+                }
+                stats::count_approximation(stats::op::sub, std::uint64_t(i - 1) + std::uint64_t(j - 1), *this, rhs,
+                    y.value());
                 return y.value();
             }
             std::make_unsigned_t<T> a_numer = static_cast<std::make_unsigned_t<T>>(a.numer < 0 ? -1 - a.numer : a.numer)
@@ -322,6 +423,7 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr fraction<T> fraction<T>::operator%(const fraction<T> rhs) const noexcept
     {
+        stats::count_call(stats::op::rem);
         fraction<T> a {*this};
         fraction<T> b {rhs};
         for(T i {1}, j {1};;)
@@ -329,6 +431,12 @@ namespace sss
             std::optional<fraction<T>> y = a.checked_rem(b);
             if(y.has_value())
             {
+                if(i != 1 || j != 1)
+                {
+                    raise_inexact();
+                }
+                stats::count_approximation(stats::op::rem, std::uint64_t(i - 1) + std::uint64_t(j - 1), *this, rhs,
+                    y.value());
                 return y.value();
             }
             std::make_unsigned_t<T> a_numer = static_cast<std::make_unsigned_t<T>>(a.numer < 0 ? -1 - a.numer : a.numer)
@@ -356,6 +464,7 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr fraction<T> fraction<T>::operator*(const fraction<T> rhs) const noexcept
     {
+        stats::count_call(stats::op::mul);
         fraction<T> a {*this};
         fraction<T> b {rhs};
         for(T i {1}, j {1};;)
@@ -363,6 +472,12 @@ namespace sss
             std::optional<fraction<T>> y = a.checked_mul(b);
             if(y.has_value())
             {
+                if(i != 1 || j != 1)
+                {
+                    raise_inexact();
+                }
+                stats::count_approximation(stats::op::mul, std::uint64_t(i - 1) + std::uint64_t(j - 1), *this, rhs,
+                    y.value());
                 return y.value();
             }
             std::make_unsigned_t<T> a_numer = static_cast<std::make_unsigned_t<T>>(a.numer < 0 ? -1 - a.numer : a.numer)
@@ -390,6 +505,7 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr fraction<T> fraction<T>::operator/(const fraction<T> rhs) const noexcept
     {
+        stats::count_call(stats::op::div);
         fraction<T> a {*this};
         fraction<T> b {rhs};
         for(T i {1}, j {1};;)
@@ -397,6 +513,12 @@ namespace sss
             std::optional<fraction<T>> y = a.checked_div(b);
             if(y.has_value())
             {
+                if(i != 1 || j != 1)
+                {
+                    raise_inexact();
+                }
+                stats::count_approximation(stats::op::div, std::uint64_t(i - 1) + std::uint64_t(j - 1), *this, rhs,
+                    y.value());
                 return y.value();
             }
             std::make_unsigned_t<T> a_numer = static_cast<std::make_unsigned_t<T>>(a.numer < 0 ? -1 - a.numer : a.numer)
@@ -452,6 +574,7 @@ namespace sss
         std::optional<fraction<T>> y {this->checked_add(rhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::add);
             return y.value();
         }
         return *this + fraction{rhs};
@@ -462,6 +585,7 @@ namespace sss
         std::optional<fraction<T>> y {this->checked_sub(rhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::sub);
             return y.value();
         }
         return *this - fraction{rhs};
@@ -472,6 +596,7 @@ namespace sss
         std::optional<fraction<T>> y {this->checked_rem(rhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::rem);
             return y.value();
         }
         return *this % fraction{rhs};
@@ -482,6 +607,7 @@ namespace sss
         std::optional<fraction<T>> y {this->checked_mul(rhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::mul);
             return y.value();
         }
         return *this * fraction{rhs};
@@ -492,6 +618,7 @@ namespace sss
         std::optional<fraction<T>> y {this->checked_div(rhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::div);
             return y.value();
         }
         return *this / fraction{rhs};
@@ -507,6 +634,7 @@ namespace sss
         std::optional<fraction<T>> y {rhs.checked_lsub(lhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::sub);
             return y.value();
         }
         return fraction{lhs} - rhs;
@@ -517,6 +645,7 @@ namespace sss
         std::optional<fraction<T>> y {rhs.checked_lrem(lhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::rem);
             return y.value();
         }
         return fraction{lhs} % rhs;
@@ -532,6 +661,7 @@ namespace sss
         std::optional<fraction<T>> y {rhs.checked_ldiv(lhs)};
         if(y.has_value())
         {
+            stats::count_call(stats::op::div);
             return y.value();
         }
         return fraction{lhs} / rhs;
@@ -847,6 +977,19 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr void fraction<T>::reduce(void) noexcept
     {
+        stats::count_reduce();
+#ifndef SSS_FRACTION_NO_LUT
+        if constexpr(sizeof(T) == 1)
+        {
+            std::make_unsigned_t<T> gcd {small_gcd(magnitude(this->numer), this->denom)};
+            if(gcd > 1)
+            {
+                this->numer = static_cast<T>(this->numer/static_cast<int>(gcd));
+                this->denom = static_cast<std::make_unsigned_t<T>>(this->denom/gcd);
+            }
+            return;
+        }
+#endif
         std::make_unsigned_t<T> gcd {static_cast<std::make_unsigned_t<T>>(std::gcd<T, std::make_unsigned_t<T>>(
             static_cast<T>(this->numer),
             static_cast<std::make_unsigned_t<T>>(this->denom)
@@ -858,9 +1001,74 @@ namespace sss
         }
     }
 
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::make_unsigned_t<T> fraction<T>::magnitude(T x) noexcept
+    {
+        return static_cast<std::make_unsigned_t<T>>(x < 0 ? -1 - x : x) + (x < 0 ? 1 : 0);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::make_unsigned_t<T> fraction<T>::small_gcd(
+        std::make_unsigned_t<T> a,
+        std::make_unsigned_t<T> b
+    ) noexcept
+    {
+#ifndef SSS_FRACTION_NO_LUT
+        if constexpr(sizeof(T) == 1)
+        {
+            return lut::gcd(a, b);
+        }
+#endif
+        return std::gcd(a, b);
+    }
+    // std::lcm wraps around, so a least common denominator that does not fit would pass for a small one. Zero when
+    // either value is, as for std::lcm.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<std::make_unsigned_t<T>> fraction<T>::checked_lcm(
+        std::make_unsigned_t<T> a,
+        std::make_unsigned_t<T> b
+    ) noexcept
+    {
+        if(a == 0 || b == 0)
+        {
+            return 0;
+        }
+        return cia::checked_mul<std::make_unsigned_t<T>>(a/std::gcd(a, b), b);
+    }
+    // Range check for the widened fast paths below; the components must already be coprime.
+    template<typename T> requires nonbool_integral<T>
+    template<typename W> requires std::signed_integral<W>
+    constexpr std::optional<fraction<T>> fraction<T>::checked_narrow(W numer, W denom) noexcept
+    {
+        if(
+            numer < static_cast<W>(std::numeric_limits<T>::min())
+            || numer > static_cast<W>(std::numeric_limits<T>::max())
+            || denom > static_cast<W>(std::numeric_limits<std::make_unsigned_t<T>>::max())
+        )
+        {
+            return std::nullopt;
+        }
+        return fraction{reduced, static_cast<T>(numer), static_cast<std::make_unsigned_t<T>>(denom)};
+    }
+
     template<typename T> requires nonbool_integral<T>
     constexpr std::optional<fraction<T>> fraction<T>::checked_add(const fraction<T>& rhs) const noexcept
     {
+#if !defined(SSS_FRACTION_NO_LUT) && defined(__SIZEOF_INT128__)
+        if constexpr(sizeof(T) <= 2)
+        {
+            if(this->denom != 0 && rhs.denom != 0)
+            {
+                using W = std::make_signed_t<wide::wider_t<wide::wider_t<T>>>;
+                std::make_unsigned_t<T> g {small_gcd(this->denom, rhs.denom)};
+                W t {W(this->numer)*W(rhs.denom/g) + W(rhs.numer)*W(this->denom/g)};
+                std::make_unsigned_t<T> h {g == 1 ? g : small_gcd(
+                    static_cast<std::make_unsigned_t<T>>((t < 0 ? -t : t) % W(g)),
+                    g
+                )};
+                return checked_narrow<W>(t/W(h), W(this->denom/g)*W(rhs.denom/h));
+            }
+        }
+#endif
         if(rhs.is_zero() || this->is_nan())
         {
             return *this;
@@ -878,7 +1086,12 @@ namespace sss
             }
             return fraction{numer.value(), this->denom};
         }
-        std::make_unsigned_t<T> lcm {std::lcm(this->denom, rhs.denom)};
+        std::optional<std::make_unsigned_t<T>> checked_denom {checked_lcm(this->denom, rhs.denom)};
+        if(!checked_denom.has_value())
+        {
+            return std::nullopt;
+        }
+        std::make_unsigned_t<T> lcm {checked_denom.value()};
         if(lcm == 0)
         {
             if(this->denom == 0 && rhs.denom == 0)
@@ -953,6 +1166,22 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr std::optional<fraction<T>> fraction<T>::checked_sub(const fraction<T>& rhs) const noexcept
     {
+#if !defined(SSS_FRACTION_NO_LUT) && defined(__SIZEOF_INT128__)
+        if constexpr(sizeof(T) <= 2)
+        {
+            if(this->denom != 0 && rhs.denom != 0)
+            {
+                using W = std::make_signed_t<wide::wider_t<wide::wider_t<T>>>;
+                std::make_unsigned_t<T> g {small_gcd(this->denom, rhs.denom)};
+                W t {W(this->numer)*W(rhs.denom/g) - W(rhs.numer)*W(this->denom/g)};
+                std::make_unsigned_t<T> h {g == 1 ? g : small_gcd(
+                    static_cast<std::make_unsigned_t<T>>((t < 0 ? -t : t) % W(g)),
+                    g
+                )};
+                return checked_narrow<W>(t/W(h), W(this->denom/g)*W(rhs.denom/h));
+            }
+        }
+#endif
         if(rhs.is_zero() || this->is_nan())
         {
             return *this;
@@ -970,7 +1199,12 @@ namespace sss
             }
             return fraction{numer.value(), this->denom};
         }
-        std::make_unsigned_t<T> lcm {std::lcm(this->denom, rhs.denom)};
+        std::optional<std::make_unsigned_t<T>> checked_denom {checked_lcm(this->denom, rhs.denom)};
+        if(!checked_denom.has_value())
+        {
+            return std::nullopt;
+        }
+        std::make_unsigned_t<T> lcm {checked_denom.value()};
         if(lcm == 0)
         {
             if(this->denom == 0 && rhs.denom == 0)
@@ -1086,7 +1320,12 @@ namespace sss
             }
             return fraction{numer.value(), this->denom};
         }
-        std::make_unsigned_t<T> lcm {std::lcm(this->denom, rhs.denom)};
+        std::optional<std::make_unsigned_t<T>> checked_denom {checked_lcm(this->denom, rhs.denom)};
+        if(!checked_denom.has_value())
+        {
+            return std::nullopt;
+        }
+        std::make_unsigned_t<T> lcm {checked_denom.value()};
         if(lcm == 0)
         {
             return fraction{0, 0};
@@ -1167,6 +1406,21 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr std::optional<fraction<T>> fraction<T>::checked_mul(const fraction<T>& rhs) const noexcept
     {
+#if !defined(SSS_FRACTION_NO_LUT) && defined(__SIZEOF_INT128__)
+        if constexpr(sizeof(T) <= 2)
+        {
+            if(this->denom != 0 && rhs.denom != 0)
+            {
+                using W = std::make_signed_t<wide::wider_t<wide::wider_t<T>>>;
+                std::make_unsigned_t<T> g {small_gcd(magnitude(this->numer), rhs.denom)};
+                std::make_unsigned_t<T> h {small_gcd(magnitude(rhs.numer), this->denom)};
+                return checked_narrow<W>(
+                    W(this->numer)/W(g)*(W(rhs.numer)/W(h)),
+                    W(this->denom/h)*W(rhs.denom/g)
+                );
+            }
+        }
+#endif
         std::make_unsigned_t<T> gcd_ad {std::gcd<std::make_unsigned_t<T>, std::make_unsigned_t<T>>(
             static_cast<std::make_unsigned_t<T>>(this->numer < 0 ? -1 - this->numer : this->numer)
                 + (this->numer < 0 ? 1 : 0),
@@ -1195,7 +1449,7 @@ namespace sss
         }
         std::optional<T> numer {cia::checked_mul<T>(
             this->numer/static_cast<T>(gcd_ad),
-            static_cast<T>(rhs.numer/gcd_bc)
+            rhs.numer/static_cast<T>(gcd_bc)
         )};
         if(!numer.has_value())
         {
@@ -1218,6 +1472,10 @@ namespace sss
             this->denom,
             static_cast<std::make_unsigned_t<T>>(rhs < 0 ? -1 - rhs : rhs) + (rhs < 0 ? 1 : 0)
         )};
+        if(gcd == 0)
+        {
+            gcd = 1;
+        }
         if(gcd > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
         {
             return std::nullopt;
@@ -1232,6 +1490,20 @@ namespace sss
     template<typename T> requires nonbool_integral<T>
     constexpr std::optional<fraction<T>> fraction<T>::checked_div(const fraction<T>& rhs) const noexcept
     {
+#if !defined(SSS_FRACTION_NO_LUT) && defined(__SIZEOF_INT128__)
+        if constexpr(sizeof(T) <= 2)
+        {
+            if(this->denom != 0 && rhs.denom != 0 && rhs.numer != 0)
+            {
+                using W = std::make_signed_t<wide::wider_t<wide::wider_t<T>>>;
+                std::make_unsigned_t<T> g {small_gcd(magnitude(this->numer), magnitude(rhs.numer))};
+                std::make_unsigned_t<T> h {small_gcd(this->denom, rhs.denom)};
+                W numer {W(this->numer)/W(g)*W(rhs.denom/h)};
+                W denom {W(this->denom/h)*(W(rhs.numer)/W(g))};
+                return denom < 0 ? checked_narrow<W>(-numer, -denom) : checked_narrow<W>(numer, denom);
+            }
+        }
+#endif
         std::make_unsigned_t<T> gcd_ac {std::gcd<std::make_unsigned_t<T>, std::make_unsigned_t<T>>(
             static_cast<std::make_unsigned_t<T>>(this->numer < 0 ? -1 - this->numer : this->numer)
                 + (this->numer < 0 ? 1 : 0),
@@ -1303,6 +1575,10 @@ namespace sss
             static_cast<std::make_unsigned_t<T>>(this->numer < 0 ? -1 - numer : numer) + (this->numer < 0 ? 1 : 0),
             static_cast<std::make_unsigned_t<T>>(rhs < 0 ? -1 - rhs : rhs) + (rhs < 0 ? 1 : 0)
         )};
+        if(gcd == 0)
+        {
+            gcd = 1;
+        }
         if(gcd > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
         {
             return std::nullopt;
@@ -1345,6 +1621,10 @@ namespace sss
             static_cast<std::make_unsigned_t<T>>(lhs < 0 ? std::make_unsigned_t<T>(-1) - lhs : lhs)
                 + std::make_unsigned_t<T>(lhs < 0 ? 1 : 0)
         )};
+        if(gcd == 0)
+        {
+            gcd = 1;
+        }
         if(gcd > static_cast<std::make_unsigned_t<T>>(std::numeric_limits<T>::max()))
         {
             return std::nullopt;
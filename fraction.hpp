@@ -12,6 +12,14 @@ namespace sss
     template<typename T>
     concept nonbool_integral = std::integral<T> && (!std::same_as<T, bool>);
 
+    struct reduced_t
+    {
+        explicit reduced_t(void) = default;
+    };
+    inline constexpr reduced_t reduced {};
+
+    class adaptive_fraction;
+
     template<typename T> requires nonbool_integral<T>
     class fraction
     {
@@ -23,6 +31,7 @@ namespace sss
             constexpr fraction(T numer, std::make_unsigned_t<T> denom) noexcept;
             constexpr fraction(T value) noexcept;
             constexpr fraction(void) noexcept;
+            constexpr fraction(reduced_t, T numer, std::make_unsigned_t<T> denom) noexcept;
 
             [[nodiscard]] constexpr T get_numer(void) const noexcept;
             [[nodiscard]] constexpr std::make_unsigned_t<T> get_denom(void) const noexcept;
@@ -44,6 +53,10 @@ namespace sss
             [[nodiscard]] constexpr fraction fract(void) const noexcept;
             template<typename I> requires nonbool_integral<I>
             [[nodiscard]] constexpr fraction pow(const I& rhs) const noexcept;
+            // The exact k-th root, or nothing when the numerator or denominator is not a perfect k-th power. A
+            // negative k takes the root of the reciprocal.
+            template<typename I> requires nonbool_integral<I>
+            [[nodiscard]] constexpr std::optional<fraction> nth_root(const I& k) const noexcept;
 
             template<typename I> requires nonbool_integral<I>
             [[nodiscard]] constexpr explicit operator fraction<I>(void) const noexcept;
@@ -121,7 +134,21 @@ namespace sss
             friend constexpr bool operator!=(std::nullptr_t, const fraction<U>& rhs) noexcept;
 
         private:
+            // Widens instead of approximating when a checked operation below fails.
+            friend class adaptive_fraction;
+
             constexpr void reduce(void) noexcept;
+            [[nodiscard]] static constexpr std::make_unsigned_t<T> magnitude(T x) noexcept;
+            [[nodiscard]] static constexpr std::make_unsigned_t<T> small_gcd(
+                std::make_unsigned_t<T> a,
+                std::make_unsigned_t<T> b
+            ) noexcept;
+            [[nodiscard]] static constexpr std::optional<std::make_unsigned_t<T>> checked_lcm(
+                std::make_unsigned_t<T> a,
+                std::make_unsigned_t<T> b
+            ) noexcept;
+            template<typename W> requires std::signed_integral<W>
+            [[nodiscard]] static constexpr std::optional<fraction> checked_narrow(W numer, W denom) noexcept;
             
             [[nodiscard]] constexpr std::optional<fraction> checked_add(const fraction& rhs) const noexcept;
             [[nodiscard]] constexpr std::optional<fraction> checked_add(const T& rhs) const noexcept;
@@ -213,4 +240,19 @@ class std::numeric_limits<sss::fraction<T>>
         }
 };
 
-#include "fraction.cpp"
\ No newline at end of file
+#include "fraction.cpp"
+
+// Opt-in: with SSS_FRACTION_EXTERN_TEMPLATES defined, the common widths are instantiated once in fraction_inst.cpp,
+// which must then be compiled and linked in, instead of in every translation unit. Constant evaluation still
+// instantiates whatever it needs.
+#ifdef SSS_FRACTION_EXTERN_TEMPLATES
+namespace sss
+{
+    extern template class fraction<int>;
+    extern template class fraction<unsigned int>;
+    extern template class fraction<long>;
+    extern template class fraction<unsigned long>;
+    extern template class fraction<long long>;
+    extern template class fraction<unsigned long long>;
+}
+#endif
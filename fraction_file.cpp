@@ -0,0 +1,330 @@
+#include "fraction_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_view<T>::iterator::iterator(void) noexcept:
+        numer{nullptr},
+        denom{nullptr}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_view<T>::iterator::iterator(const T* numer, const std::make_unsigned_t<T>* denom) noexcept:
+        numer{numer},
+        denom{denom}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_view<T>::iterator::operator*(void) const noexcept
+    {
+        return fraction<T>{reduced, *this->numer, *this->denom};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_view<T>::iterator::operator[](difference_type n) const noexcept
+    {
+        return fraction<T>{reduced, this->numer[n], this->denom[n]};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator& fraction_view<T>::iterator::operator++(void) noexcept
+    {
+        ++this->numer;
+        ++this->denom;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::iterator::operator++(int) noexcept
+    {
+        iterator x {*this};
+        ++*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator& fraction_view<T>::iterator::operator--(void) noexcept
+    {
+        --this->numer;
+        --this->denom;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::iterator::operator--(int) noexcept
+    {
+        iterator x {*this};
+        --*this;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator& fraction_view<T>::iterator::operator+=(difference_type n) noexcept
+    {
+        this->numer += n;
+        this->denom += n;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator& fraction_view<T>::iterator::operator-=(difference_type n) noexcept
+    {
+        this->numer -= n;
+        this->denom -= n;
+        return *this;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::iterator::operator+(difference_type n) const noexcept
+    {
+        return iterator{this->numer + n, this->denom + n};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::iterator::operator-(difference_type n) const noexcept
+    {
+        return iterator{this->numer - n, this->denom - n};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator::difference_type fraction_view<T>::iterator::operator-(
+        const iterator& rhs
+    ) const noexcept
+    {
+        return this->numer - rhs.numer;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_view<T>::iterator::operator==(const iterator& rhs) const noexcept
+    {
+        return this->numer == rhs.numer;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::strong_ordering fraction_view<T>::iterator::operator<=>(const iterator& rhs) const noexcept
+    {
+        return this->numer <=> rhs.numer;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_view<T>::fraction_view(void) noexcept:
+        numers{nullptr},
+        denoms{nullptr},
+        count{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_view<T>::fraction_view(
+        std::span<const T> numers,
+        std::span<const std::make_unsigned_t<T>> denoms
+    ) noexcept:
+        numers{numers.data()},
+        denoms{denoms.data()},
+        count{std::min(numers.size(), denoms.size())}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::begin(void) const noexcept
+    {
+        return iterator{this->numers, this->denoms};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_view<T>::iterator fraction_view<T>::end(void) const noexcept
+    {
+        return iterator{this->numers + this->count, this->denoms + this->count};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::size_t fraction_view<T>::size(void) const noexcept
+    {
+        return this->count;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_view<T>::operator[](std::size_t i) const noexcept
+    {
+        return fraction<T>{reduced, this->numers[i], this->denoms[i]};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_view<T> fraction_view<T>::subview(std::size_t offset, std::size_t count) const noexcept
+    {
+        offset = std::min(offset, this->count);
+        count = std::min(count, this->count - offset);
+        return fraction_view{
+            std::span<const T>{this->numers + offset, count},
+            std::span<const std::make_unsigned_t<T>>{this->denoms + offset, count}
+        };
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::span<const T> fraction_view<T>::get_numers(void) const noexcept
+    {
+        return {this->numers, this->count};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::span<const std::make_unsigned_t<T>> fraction_view<T>::get_denoms(void) const noexcept
+    {
+        return {this->denoms, this->count};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    mapped_fraction_file<T>::mapped_fraction_file(mapped_file&& file, fraction_view<T> values) noexcept:
+        file{std::move(file)},
+        values{values}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    std::optional<mapped_fraction_file<T>> mapped_fraction_file<T>::open(
+        const std::string& path,
+        bool validate
+    ) noexcept
+    {
+        std::optional<mapped_file> file {mapped_file::open(path)};
+        if(!file.has_value())
+        {
+            return std::nullopt;
+        }
+        std::size_t size {file->get_size()};
+        if(size < sizeof(fraction_file_header))
+        {
+            return std::nullopt;
+        }
+        fraction_file_header header;
+        std::memcpy(&header, file->get_data(), sizeof(fraction_file_header));
+        if(
+            header.magic != fraction_file_magic
+            || header.byte_order != fraction_file_byte_order
+            || header.version != fraction_file_version
+            || header.width != sizeof(T)
+            || header.is_signed != std::is_signed<T>::value
+        )
+        {
+            return std::nullopt;
+        }
+        if(header.numer_offset % fraction_file_alignment != 0 || header.denom_offset % fraction_file_alignment != 0)
+        {
+            return std::nullopt;
+        }
+        if(
+            header.count > size/sizeof(T)
+            || header.numer_offset > size
+            || header.denom_offset > size
+            || header.count*sizeof(T) > size - header.numer_offset
+            || header.count*sizeof(T) > size - header.denom_offset
+        )
+        {
+            return std::nullopt;
+        }
+        std::size_t count {static_cast<std::size_t>(header.count)};
+        fraction_view<T> values {
+            std::span<const T>{reinterpret_cast<const T*>(file->get_data() + header.numer_offset), count},
+            std::span<const std::make_unsigned_t<T>>{
+                reinterpret_cast<const std::make_unsigned_t<T>*>(file->get_data() + header.denom_offset),
+                count
+            }
+        };
+        if(validate && !is_canonical(values))
+        {
+            return std::nullopt;
+        }
+        return mapped_fraction_file{std::move(file.value()), values};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    fraction_view<T> mapped_fraction_file<T>::view(void) const noexcept
+    {
+        return this->values;
+    }
+    template<typename T> requires nonbool_integral<T>
+    std::size_t mapped_fraction_file<T>::size(void) const noexcept
+    {
+        return this->values.size();
+    }
+    template<typename T> requires nonbool_integral<T>
+    typename fraction_view<T>::iterator mapped_fraction_file<T>::begin(void) const noexcept
+    {
+        return this->values.begin();
+    }
+    template<typename T> requires nonbool_integral<T>
+    typename fraction_view<T>::iterator mapped_fraction_file<T>::end(void) const noexcept
+    {
+        return this->values.end();
+    }
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> mapped_fraction_file<T>::operator[](std::size_t i) const noexcept
+    {
+        return this->values[i];
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool is_canonical(const fraction_view<T>& values) noexcept
+    {
+        std::span<const T> numers {values.get_numers()};
+        std::span<const std::make_unsigned_t<T>> denoms {values.get_denoms()};
+        for(std::size_t i {0}; i < values.size(); ++i)
+        {
+            std::make_unsigned_t<T> numer {static_cast<std::make_unsigned_t<T>>(numers[i])};
+            if(numers[i] < 0)
+            {
+                numer = static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0) - numer);
+            }
+            if(std::gcd(numer, denoms[i]) != 1 && !(numer == 0 && denoms[i] == 0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    bool write_fraction_file(const std::string& path, std::span<const fraction<T>> values) noexcept
+    {
+        constexpr std::size_t chunk {4096};
+
+        auto align = [](std::uint64_t offset) -> std::uint64_t
+        {
+            return (offset + fraction_file_alignment - 1)/fraction_file_alignment*fraction_file_alignment;
+        };
+
+        std::ofstream out {path, std::ios::binary | std::ios::trunc};
+        if(!out)
+        {
+            return false;
+        }
+        fraction_file_header header {
+            fraction_file_magic,
+            fraction_file_byte_order,
+            fraction_file_version,
+            static_cast<std::uint8_t>(sizeof(T)),
+            static_cast<std::uint8_t>(std::is_signed<T>::value),
+            values.size(),
+            align(sizeof(fraction_file_header)),
+            align(align(sizeof(fraction_file_header)) + values.size()*sizeof(T))
+        };
+        std::uint64_t offset {0};
+        auto pad = [&](std::uint64_t to)
+        {
+            constexpr std::array<char, fraction_file_alignment> zeros {};
+            out.write(zeros.data(), static_cast<std::streamsize>(to - offset));
+            offset = to;
+        };
+        auto write_column = [&](auto component)
+        {
+            using C = decltype(component(values.front()));
+            std::array<C, chunk> buffer;
+            for(std::size_t i {0}; i < values.size(); i += chunk)
+            {
+                std::size_t n {std::min(chunk, values.size() - i)};
+                std::transform(values.begin() + i, values.begin() + i + n, buffer.begin(), component);
+                out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(n*sizeof(C)));
+            }
+            offset += values.size()*sizeof(C);
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(fraction_file_header));
+        offset = sizeof(fraction_file_header);
+        pad(header.numer_offset);
+        write_column([](const fraction<T>& x) { return x.get_numer(); });
+        pad(header.denom_offset);
+        write_column([](const fraction<T>& x) { return x.get_denom(); });
+        return static_cast<bool>(out.flush());
+    }
+}
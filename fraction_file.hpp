@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+
+#include "fraction.hpp"
+#include "mapped_file.hpp"
+
+namespace sss
+{
+    // On-disk layout: a fraction_file_header, then `count` numerators starting at `numer_offset`, then `count`
+    // denominators starting at `denom_offset`. Both offsets are multiples of fraction_file_alignment and all values
+    // are stored in native byte order, already reduced.
+    struct fraction_file_header
+    {
+        std::array<char, 8> magic;
+        std::uint32_t byte_order;
+        std::uint16_t version;
+        std::uint8_t width;
+        std::uint8_t is_signed;
+        std::uint64_t count;
+        std::uint64_t numer_offset;
+        std::uint64_t denom_offset;
+    };
+
+    inline constexpr std::array<char, 8> fraction_file_magic {'S', 'S', 'S', 'F', 'R', 'A', 'C', '\0'};
+    inline constexpr std::uint32_t fraction_file_byte_order {0x01020304};
+    inline constexpr std::uint16_t fraction_file_version {1};
+    inline constexpr std::size_t fraction_file_alignment {64};
+
+    template<typename T> requires nonbool_integral<T>
+    class fraction_view : public std::ranges::view_interface<fraction_view<T>>
+    {
+        public:
+            class iterator
+            {
+                private:
+                    const T* numer;
+                    const std::make_unsigned_t<T>* denom;
+
+                public:
+                    using iterator_concept = std::random_access_iterator_tag;
+                    using iterator_category = std::input_iterator_tag;
+                    using value_type = fraction<T>;
+                    using difference_type = std::ptrdiff_t;
+
+                    constexpr iterator(void) noexcept;
+                    constexpr iterator(const T* numer, const std::make_unsigned_t<T>* denom) noexcept;
+
+                    [[nodiscard]] constexpr fraction<T> operator*(void) const noexcept;
+                    [[nodiscard]] constexpr fraction<T> operator[](difference_type n) const noexcept;
+                    constexpr iterator& operator++(void) noexcept;
+                    constexpr iterator operator++(int) noexcept;
+                    constexpr iterator& operator--(void) noexcept;
+                    constexpr iterator operator--(int) noexcept;
+                    constexpr iterator& operator+=(difference_type n) noexcept;
+                    constexpr iterator& operator-=(difference_type n) noexcept;
+                    [[nodiscard]] constexpr iterator operator+(difference_type n) const noexcept;
+                    [[nodiscard]] constexpr iterator operator-(difference_type n) const noexcept;
+                    [[nodiscard]] constexpr difference_type operator-(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr bool operator==(const iterator& rhs) const noexcept;
+                    [[nodiscard]] constexpr std::strong_ordering operator<=>(const iterator& rhs) const noexcept;
+
+                    [[nodiscard]] friend constexpr iterator operator+(difference_type n, const iterator& rhs) noexcept
+                    {
+                        return rhs + n;
+                    }
+            };
+
+        private:
+            const T* numers;
+            const std::make_unsigned_t<T>* denoms;
+            std::size_t count;
+
+        public:
+            constexpr fraction_view(void) noexcept;
+            constexpr fraction_view(std::span<const T> numers, std::span<const std::make_unsigned_t<T>> denoms) noexcept;
+
+            [[nodiscard]] constexpr iterator begin(void) const noexcept;
+            [[nodiscard]] constexpr iterator end(void) const noexcept;
+            [[nodiscard]] constexpr std::size_t size(void) const noexcept;
+            [[nodiscard]] constexpr fraction<T> operator[](std::size_t i) const noexcept;
+            [[nodiscard]] constexpr fraction_view subview(std::size_t offset, std::size_t count) const noexcept;
+            [[nodiscard]] constexpr std::span<const T> get_numers(void) const noexcept;
+            [[nodiscard]] constexpr std::span<const std::make_unsigned_t<T>> get_denoms(void) const noexcept;
+    };
+
+    template<typename T> requires nonbool_integral<T>
+    class mapped_fraction_file
+    {
+        private:
+            mapped_file file;
+            fraction_view<T> values;
+
+            mapped_fraction_file(mapped_file&& file, fraction_view<T> values) noexcept;
+
+        public:
+            [[nodiscard]] static std::optional<mapped_fraction_file> open(
+                const std::string& path,
+                bool validate = true
+            ) noexcept;
+
+            [[nodiscard]] fraction_view<T> view(void) const noexcept;
+            [[nodiscard]] std::size_t size(void) const noexcept;
+            [[nodiscard]] typename fraction_view<T>::iterator begin(void) const noexcept;
+            [[nodiscard]] typename fraction_view<T>::iterator end(void) const noexcept;
+            [[nodiscard]] fraction<T> operator[](std::size_t i) const noexcept;
+    };
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr bool is_canonical(const fraction_view<T>& values) noexcept;
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] bool write_fraction_file(const std::string& path, std::span<const fraction<T>> values) noexcept;
+}
+
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sss::fraction_view<T>> = true;
+
+#include "fraction_file.cpp"
@@ -0,0 +1,14 @@
+// Explicit instantiations behind the extern template declarations in fraction.hpp. Compile this file once, e.g.
+// `g++ -std=c++23 -O2 -c fraction_inst.cpp`, and link it into programs built with -DSSS_FRACTION_EXTERN_TEMPLATES.
+
+#include "fraction.hpp"
+
+namespace sss
+{
+    template class fraction<int>;
+    template class fraction<unsigned int>;
+    template class fraction<long>;
+    template class fraction<unsigned long>;
+    template class fraction<long long>;
+    template class fraction<unsigned long long>;
+}
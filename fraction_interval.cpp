@@ -0,0 +1,394 @@
+#include "fraction_interval.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>::fraction_interval(void) noexcept:
+        lower{0},
+        upper{0}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>::fraction_interval(fraction<T> x) noexcept:
+        lower{x},
+        upper{x}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>::fraction_interval(fraction<T> lower, fraction<T> upper) noexcept:
+        lower{lower},
+        upper{upper}
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_interval<T>::get_lower(void) const noexcept
+    {
+        return this->lower;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_interval<T>::get_upper(void) const noexcept
+    {
+        return this->upper;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::is_nan(void) const noexcept
+    {
+        return this->lower.is_nan() || this->upper.is_nan();
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::is_exact(void) const noexcept
+    {
+        return !this->is_nan() && !less(this->lower, this->upper);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::contains(const fraction<T>& x) const noexcept
+    {
+        return !this->is_nan() && !x.is_nan() && !less(x, this->lower) && !less(this->upper, x);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_interval<T>::width(void) const noexcept
+    {
+        if(this->is_nan())
+        {
+            return fraction<T>{0, 0};
+        }
+        return round(add(to_term(this->upper), negate(to_term(this->lower)), true), true);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::operator+(const fraction_interval<T>& rhs) const noexcept
+    {
+        if(this->is_nan() || rhs.is_nan())
+        {
+            return nan();
+        }
+        fraction<T> l {round(add(to_term(this->lower), to_term(rhs.lower), false), false)};
+        fraction<T> u {round(add(to_term(this->upper), to_term(rhs.upper), true), true)};
+        if(l.is_nan() || u.is_nan())
+        {
+            return nan();
+        }
+        return {l, u};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::operator-(const fraction_interval<T>& rhs) const noexcept
+    {
+        if(this->is_nan() || rhs.is_nan())
+        {
+            return nan();
+        }
+        fraction<T> l {round(add(to_term(this->lower), negate(to_term(rhs.upper)), false), false)};
+        fraction<T> u {round(add(to_term(this->upper), negate(to_term(rhs.lower)), true), true)};
+        if(l.is_nan() || u.is_nan())
+        {
+            return nan();
+        }
+        return {l, u};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::operator*(const fraction_interval<T>& rhs) const noexcept
+    {
+        if(this->is_nan() || rhs.is_nan())
+        {
+            return nan();
+        }
+        term a {to_term(this->lower)};
+        term b {to_term(this->upper)};
+        term c {to_term(rhs.lower)};
+        term d {to_term(rhs.upper)};
+        return hull({mul(a, c), mul(a, d), mul(b, c), mul(b, d)});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::operator/(const fraction_interval<T>& rhs) const noexcept
+    {
+        if(this->is_nan() || rhs.is_nan())
+        {
+            return nan();
+        }
+        if(!less(fraction<T>{0}, rhs.lower) && !less(rhs.upper, fraction<T>{0}))
+        {
+            return whole();
+        }
+        term a {to_term(this->lower)};
+        term b {to_term(this->upper)};
+        term c {reciprocal(to_term(rhs.lower))};
+        term d {reciprocal(to_term(rhs.upper))};
+        return hull({mul(a, c), mul(a, d), mul(b, c), mul(b, d)});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>& fraction_interval<T>::operator+=(const fraction_interval<T>& rhs) noexcept
+    {
+        return *this = *this + rhs;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>& fraction_interval<T>::operator-=(const fraction_interval<T>& rhs) noexcept
+    {
+        return *this = *this - rhs;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>& fraction_interval<T>::operator*=(const fraction_interval<T>& rhs) noexcept
+    {
+        return *this = *this*rhs;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T>& fraction_interval<T>::operator/=(const fraction_interval<T>& rhs) noexcept
+    {
+        return *this = *this/rhs;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::operator-(void) const noexcept
+    {
+        if(this->is_nan())
+        {
+            return nan();
+        }
+        fraction<T> l {round(negate(to_term(this->upper)), false)};
+        fraction<T> u {round(negate(to_term(this->lower)), true)};
+        if(l.is_nan() || u.is_nan())
+        {
+            return nan();
+        }
+        return {l, u};
+    }
+    // Endpoints are always reduced, so equal intervals have identical endpoints. NaN intervals equal nothing.
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::operator==(const fraction_interval<T>& rhs) const noexcept
+    {
+        return !this->is_nan() && !rhs.is_nan()
+            && this->lower.get_numer() == rhs.lower.get_numer() && this->lower.get_denom() == rhs.lower.get_denom()
+            && this->upper.get_numer() == rhs.upper.get_numer() && this->upper.get_denom() == rhs.upper.get_denom();
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::operator!=(const fraction_interval<T>& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::nan(void) noexcept
+    {
+        return {fraction<T>{0, 0}, fraction<T>{0, 0}};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::whole(void) noexcept
+    {
+        if constexpr(std::is_signed<T>::value)
+        {
+            return {fraction<T>{-1, 0}, fraction<T>{1, 0}};
+        }
+        else
+        {
+            return {fraction<T>{0}, fraction<T>{1, 0}};
+        }
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_interval<T>::term fraction_interval<T>::to_term(const fraction<T>& x) noexcept
+    {
+        std::make_unsigned_t<T> numer {static_cast<std::make_unsigned_t<T>>(x.get_numer())};
+        if(x.get_numer() < 0)
+        {
+            numer = static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(0) - numer);
+        }
+        return {x.get_numer() < 0, wide_t(numer), wide_t(x.get_denom())};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_interval<T>::term fraction_interval<T>::negate(term x) noexcept
+    {
+        x.negative = !x.negative && x.numer != 0;
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_interval<T>::term fraction_interval<T>::reciprocal(term x) noexcept
+    {
+        return {x.negative, x.denom, x.numer};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_interval<T>::term fraction_interval<T>::add(const term& a, const term& b, bool up) noexcept
+    {
+        if(a.denom == 0 || b.denom == 0)
+        {
+            if(a.denom == 0 && b.denom == 0 && a.negative != b.negative)
+            {
+                return {false, 0, 0};
+            }
+            return a.denom == 0 ? a : b;
+        }
+        wide_t x {a.numer*b.denom};
+        wide_t y {b.numer*a.denom};
+        wide_t denom {a.denom*b.denom};
+        if(a.negative != b.negative)
+        {
+            if(x >= y)
+            {
+                return {x != y && a.negative, x - y, denom};
+            }
+            return {b.negative, y - x, denom};
+        }
+        wide_t numer {x + y};
+        if(numer >= x)
+        {
+            return {a.negative, numer, denom};
+        }
+        // The sum carried out of wide_t. Halving it keeps the result one bit short of exact, rounded the same way
+        // as the endpoint it is for.
+        bool magnitude_up {up != a.negative};
+        numer = ((numer >> 1) | (wide_t(1) << (sizeof(wide_t)*CHAR_BIT - 1))) + (magnitude_up ? (numer & 1) : 0);
+        denom = magnitude_up ? denom >> 1 : (denom >> 1) + (denom & 1);
+        return {a.negative, numer, denom};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fraction_interval<T>::term fraction_interval<T>::mul(const term& a, const term& b) noexcept
+    {
+        // 0 times an infinite endpoint is 0: the endpoint bounds a set of finite values, not a value.
+        if(a.numer == 0 || b.numer == 0)
+        {
+            return {false, 0, 1};
+        }
+        return {a.negative != b.negative, a.numer*b.numer, a.denom*b.denom};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool fraction_interval<T>::less(const fraction<T>& a, const fraction<T>& b) noexcept
+    {
+        term x {to_term(a)};
+        term y {to_term(b)};
+        if(x.negative != y.negative)
+        {
+            return x.negative;
+        }
+        wide_t l {x.numer*y.denom};
+        wide_t r {y.numer*x.denom};
+        return x.negative ? r < l : l < r;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fraction_interval<T>::round(const term& x, bool up) noexcept
+    {
+        if(x.numer == 0 && x.denom == 0)
+        {
+            return fraction<T>{0, 0};
+        }
+        wide_t max_numer {wide_t(std::numeric_limits<T>::max())};
+        if(x.negative)
+        {
+            max_numer = std::is_signed<T>::value ? max_numer + 1 : 0;
+        }
+        wide_t numer {1};
+        wide_t denom {0};
+        if(x.denom != 0)
+        {
+            if(x.numer <= max_numer && x.denom <= wide_t(std::numeric_limits<std::make_unsigned_t<T>>::max()))
+            {
+                numer = x.numer;
+                denom = x.denom;
+            }
+            else
+            {
+                std::pair<wide_t, wide_t> r {round_magnitude(x.numer, x.denom, up != x.negative, max_numer)};
+                numer = r.first;
+                denom = r.second;
+            }
+        }
+        if(!x.negative || numer == 0)
+        {
+            return fraction<T>{static_cast<T>(numer), static_cast<std::make_unsigned_t<T>>(denom)};
+        }
+        if constexpr(!std::is_signed<T>::value)
+        {
+            return fraction<T>{0, 0};
+        }
+        else
+        {
+            return fraction<T>{
+                static_cast<T>(std::make_unsigned_t<T>(0) - static_cast<std::make_unsigned_t<T>>(numer)),
+                static_cast<std::make_unsigned_t<T>>(denom)
+            };
+        }
+    }
+    // Walks the continued fraction of numer/denom. Once the next convergent would leave the bounds, the best
+    // semiconvergent that still fits and the previous convergent are the closest representable fractions on
+    // either side, since anything strictly between them has a larger numerator and denominator than both.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::pair<typename fraction_interval<T>::wide_t, typename fraction_interval<T>::wide_t>
+    fraction_interval<T>::round_magnitude(wide_t numer, wide_t denom, bool up, wide_t max_numer) noexcept
+    {
+        wide_t max_denom {wide_t(std::numeric_limits<std::make_unsigned_t<T>>::max())};
+        if(max_numer == 0 && numer != 0)
+        {
+            return up ? std::pair<wide_t, wide_t>{1, 0} : std::pair<wide_t, wide_t>{0, 1};
+        }
+        wide_t p0 {0};
+        wide_t q0 {1};
+        wide_t p1 {1};
+        wide_t q1 {0};
+        for(bool below {true};; below = !below)
+        {
+            wide_t a {numer/denom};
+            wide_t t {a};
+            if(p1 != 0)
+            {
+                t = std::min(t, wide_t((max_numer - p0)/p1));
+            }
+            if(q1 != 0)
+            {
+                t = std::min(t, wide_t((max_denom - q0)/q1));
+            }
+            if(t < a)
+            {
+                if(up == below)
+                {
+                    return {p1, q1};
+                }
+                return {t*p1 + p0, t*q1 + q0};
+            }
+            wide_t p {a*p1 + p0};
+            wide_t q {a*q1 + q0};
+            wide_t r {numer - a*denom};
+            if(r == 0)
+            {
+                return {p, q};
+            }
+            p0 = p1;
+            q0 = q1;
+            p1 = p;
+            q1 = q;
+            numer = denom;
+            denom = r;
+        }
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction_interval<T> fraction_interval<T>::hull(const std::array<term, 4>& x) noexcept
+    {
+        fraction<T> l {round(x[0], false)};
+        fraction<T> u {round(x[0], true)};
+        for(std::size_t i {1}; i < x.size(); ++i)
+        {
+            fraction<T> d {round(x[i], false)};
+            fraction<T> e {round(x[i], true)};
+            if(d.is_nan() || e.is_nan())
+            {
+                return nan();
+            }
+            if(less(d, l))
+            {
+                l = d;
+            }
+            if(less(u, e))
+            {
+                u = e;
+            }
+        }
+        if(l.is_nan() || u.is_nan())
+        {
+            return nan();
+        }
+        return {l, u};
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // A closed interval [lower, upper] that is guaranteed to contain the exact result of every operation applied to
+    // it. Endpoints are computed exactly in twice the width of T and, when that does not fit in fraction<T>, rounded
+    // outward to the nearest representable fraction (the lower one down, the upper one up) rather than approximated
+    // the way fraction's operators do. A bound that cannot be represented becomes an infinity; unsigned intervals
+    // whose lower bound would be negative become NaN, as does anything computed from a NaN endpoint.
+    template<typename T> requires nonbool_integral<T>
+    class fraction_interval
+    {
+        private:
+            fraction<T> lower;
+            fraction<T> upper;
+
+        public:
+            constexpr fraction_interval(void) noexcept;
+            constexpr fraction_interval(fraction<T> x) noexcept;
+            constexpr fraction_interval(fraction<T> lower, fraction<T> upper) noexcept;
+
+            [[nodiscard]] constexpr fraction<T> get_lower(void) const noexcept;
+            [[nodiscard]] constexpr fraction<T> get_upper(void) const noexcept;
+            [[nodiscard]] constexpr bool is_nan(void) const noexcept;
+            [[nodiscard]] constexpr bool is_exact(void) const noexcept;
+            [[nodiscard]] constexpr bool contains(const fraction<T>& x) const noexcept;
+            // upper - lower, rounded up.
+            [[nodiscard]] constexpr fraction<T> width(void) const noexcept;
+
+            [[nodiscard]] constexpr fraction_interval operator+(const fraction_interval& rhs) const noexcept;
+            [[nodiscard]] constexpr fraction_interval operator-(const fraction_interval& rhs) const noexcept;
+            [[nodiscard]] constexpr fraction_interval operator*(const fraction_interval& rhs) const noexcept;
+            [[nodiscard]] constexpr fraction_interval operator/(const fraction_interval& rhs) const noexcept;
+            constexpr fraction_interval& operator+=(const fraction_interval& rhs) noexcept;
+            constexpr fraction_interval& operator-=(const fraction_interval& rhs) noexcept;
+            constexpr fraction_interval& operator*=(const fraction_interval& rhs) noexcept;
+            constexpr fraction_interval& operator/=(const fraction_interval& rhs) noexcept;
+            [[nodiscard]] constexpr fraction_interval operator-(void) const noexcept;
+            [[nodiscard]] constexpr bool operator==(const fraction_interval& rhs) const noexcept;
+            [[nodiscard]] constexpr bool operator!=(const fraction_interval& rhs) const noexcept;
+
+        private:
+            // At least 32 bits, so that arithmetic on it is never promoted to int.
+            using wide_t = std::conditional_t<
+                sizeof(T) == 1,
+                std::uint32_t,
+                wide::wider_t<std::make_unsigned_t<T>>
+            >;
+
+            // An exact value as a sign and magnitude. A product of two fraction<T> parts always fits in wide_t; a
+            // denominator of 0 is an infinity and 0/0 is NaN.
+            struct term
+            {
+                bool negative;
+                wide_t numer;
+                wide_t denom;
+            };
+
+            [[nodiscard]] static constexpr fraction_interval nan(void) noexcept;
+            [[nodiscard]] static constexpr fraction_interval whole(void) noexcept;
+
+            [[nodiscard]] static constexpr term to_term(const fraction<T>& x) noexcept;
+            [[nodiscard]] static constexpr term negate(term x) noexcept;
+            [[nodiscard]] static constexpr term reciprocal(term x) noexcept;
+            [[nodiscard]] static constexpr term add(const term& a, const term& b, bool up) noexcept;
+            [[nodiscard]] static constexpr term mul(const term& a, const term& b) noexcept;
+            [[nodiscard]] static constexpr bool less(const fraction<T>& a, const fraction<T>& b) noexcept;
+            [[nodiscard]] static constexpr fraction<T> round(const term& x, bool up) noexcept;
+            [[nodiscard]] static constexpr std::pair<wide_t, wide_t> round_magnitude(
+                wide_t numer,
+                wide_t denom,
+                bool up,
+                wide_t max_numer
+            ) noexcept;
+            [[nodiscard]] static constexpr fraction_interval hull(const std::array<term, 4>& x) noexcept;
+    };
+}
+
+#include "fraction_interval.cpp"
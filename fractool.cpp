@@ -0,0 +1,475 @@
+// Bulk operations over fractions in a text file, one per line, as an integer, n/d, or a decimal such as -1.25.
+//
+// Build: g++ -std=c++23 -O2 -pthread fractool.cpp -o fractool
+//
+//   fractool sum [FILE]                       the exact sum, approximated once only when it overflows 64 bits
+//   fractool min [FILE] / fractool max [FILE]
+//   fractool sort [FILE]                      every value, reduced, in ascending order
+//   fractool decimal [FILE] --digits N        every value as a decimal, truncated to N digits (default 6)
+//   fractool limit [FILE] --max-denom N       every value as its closest convergent with a denominator up to N
+//
+// With no FILE, or FILE -, stdin is read. The input is mapped rather than read when it is a regular file, cut into
+// one chunk per thread at line boundaries, and parsed and processed in parallel (--threads K, default all cores).
+// Values are printed with operator std::string. --stats reports the input size, the number of values and the
+// throughput on stderr. Blank lines are skipped; any other line that does not parse stops the run with exit
+// status 1 and the byte offset of the line. A bad command line, including an option value that is not a whole
+// number, prints the usage with exit status 2.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "continued_fraction.hpp"
+#include "fraction.hpp"
+#include "fused.hpp"
+#include "mapped_file.hpp"
+#include "sort.hpp"
+#include "status.hpp"
+#include "wide.hpp"
+
+using f = sss::fraction<long long>;
+using arithmetic = sss::fused_arithmetic<long long>;
+
+// operator< cross-multiplies in long long, which overflows once numerators and denominators pass about 3e9; min and
+// max compare like sort, in 128 bits.
+constexpr sss::fraction_sorter<long long>::less exact_less {};
+
+struct options
+{
+    std::string op {};
+    std::string path {"-"};
+    unsigned threads {std::max(1u, std::thread::hardware_concurrency())};
+    unsigned digits {6};
+    unsigned long long max_denom {1000000};
+    bool stats {false};
+};
+
+struct chunk
+{
+    std::vector<f> values {};
+    arithmetic::wide_exact sum {};
+    f special {0};
+    std::size_t count {0};
+    std::string out {};
+    std::optional<std::size_t> error {};
+    bool inexact {false};
+};
+
+// n, n/d or a decimal, with optional surrounding spaces, tabs and a trailing \r. The numerator and denominator are
+// read with std::from_chars, so there is no allocation and no locale.
+std::optional<f> parse(std::string_view line)
+{
+    auto space = [](char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+    while(!line.empty() && space(line.front()))
+    {
+        line.remove_prefix(1);
+    }
+    while(!line.empty() && space(line.back()))
+    {
+        line.remove_suffix(1);
+    }
+    const char* first {line.data()};
+    const char* last {line.data() + line.size()};
+    long long numer {0};
+    std::from_chars_result r {std::from_chars(first, last, numer)};
+    if(r.ec != std::errc{})
+    {
+        return std::nullopt;
+    }
+    if(r.ptr == last)
+    {
+        return f{numer};
+    }
+    if(*r.ptr == '/')
+    {
+        unsigned long long denom {0};
+        std::from_chars_result s {std::from_chars(r.ptr + 1, last, denom)};
+        if(s.ec != std::errc{} || s.ptr != last)
+        {
+            return std::nullopt;
+        }
+        return f{numer, denom};
+    }
+    if(*r.ptr != '.' || r.ptr + 1 == last)
+    {
+        return std::nullopt;
+    }
+    bool negative {*first == '-'};
+    unsigned long long denom {1};
+    for(const char* p {r.ptr + 1}; p != last; ++p)
+    {
+        if(*p < '0' || *p > '9' || __builtin_mul_overflow(denom, 10ull, &denom)
+            || __builtin_mul_overflow(numer, 10ll, &numer)
+            || __builtin_add_overflow(numer, negative ? '0' - *p : *p - '0', &numer))
+        {
+            return std::nullopt;
+        }
+    }
+    return f{numer, denom};
+}
+
+// An option's value, a whole number in decimal with nothing around it, or nothing when it is not one.
+std::optional<unsigned long long> number(std::string_view s)
+{
+    unsigned long long n {0};
+    std::from_chars_result r {std::from_chars(s.data(), s.data() + s.size(), n)};
+    if(s.empty() || r.ec != std::errc{} || r.ptr != s.data() + s.size())
+    {
+        return std::nullopt;
+    }
+    return n;
+}
+
+// x truncated toward zero to `digits` decimal places, by long division of the remainder.
+std::string decimal(const f& x, unsigned digits)
+{
+    if(!x.is_finite())
+    {
+        return static_cast<std::string>(x);
+    }
+    bool negative {x.get_numer() < 0};
+    sss::wide::uint128_t numer {static_cast<unsigned long long>(x.get_numer())};
+    if(negative)
+    {
+        numer = static_cast<unsigned long long>(0ull - static_cast<unsigned long long>(x.get_numer()));
+    }
+    sss::wide::uint128_t denom {x.get_denom()};
+    std::string s {negative ? "-" : ""};
+    s += std::to_string(static_cast<unsigned long long>(numer/denom));
+    sss::wide::uint128_t rem {numer % denom};
+    if(digits > 0)
+    {
+        s += '.';
+    }
+    for(unsigned i {0}; i < digits; ++i)
+    {
+        rem *= 10;
+        s += static_cast<char>('0' + static_cast<int>(rem/denom));
+        rem %= denom;
+    }
+    return s;
+}
+
+// The closest fraction with a denominator up to max_denom is either the last convergent within the bound or the
+// largest semiconvergent after it that is, as in Python's Fraction.limit_denominator(). Both are closer to x than
+// 1/q, so x*q - p is below x's denominator and can be taken modulo 2^128, and the two errors compared exactly.
+f limit(const f& x, unsigned long long max_denom)
+{
+    if(!x.is_finite() || x.get_denom() <= max_denom)
+    {
+        return x;
+    }
+    f before {1, 0};
+    f last {1, 0};
+    for(const f& c : sss::convergents(x, max_denom))
+    {
+        before = last;
+        last = c;
+    }
+    unsigned long long k {(max_denom - before.get_denom())/last.get_denom()};
+    if(k == 0)
+    {
+        return last;
+    }
+    f semi {static_cast<long long>(before.get_numer() + static_cast<long long>(k)*last.get_numer()),
+        before.get_denom() + k*last.get_denom()};
+    auto error = [&x](const f& c)
+    {
+        sss::wide::uint128_t d {sss::wide::uint128_t(x.get_numer())*c.get_denom()
+            - sss::wide::uint128_t(c.get_numer())*x.get_denom()};
+        return static_cast<sss::wide::int128_t>(d) < 0 ? -d : d;
+    };
+    return error(semi)*last.get_denom() < error(last)*semi.get_denom() ? semi : last;
+}
+
+// a + b in 256 bits, each side first rounded to the 128-bit accumulator, which only loses anything when that side
+// has outgrown it.
+arithmetic::wide_exact add(const arithmetic::wide_exact& a, const arithmetic::wide_exact& b)
+{
+    return arithmetic::wide_add(arithmetic::widen(arithmetic::shorten(a)), arithmetic::widen(arithmetic::shorten(b)));
+}
+
+// The sum of the finite values, exact in the accumulator of fused_arithmetic while it fits and carried in 256 bits
+// after that, so it is only ever rounded to the accumulator's precision, far finer than f's. Infinities and NaN
+// are added up in special instead.
+arithmetic::wide_exact sum(const std::vector<f>& values, f& special)
+{
+    arithmetic::exact x {0, 1};
+    std::optional<arithmetic::wide_exact> wide {};
+    for(const f& v : values)
+    {
+        if(!v.is_finite())
+        {
+            special = special + v;
+            continue;
+        }
+        arithmetic::exact y {v.get_numer(), v.get_denom()};
+        if(!wide)
+        {
+            if(std::optional<arithmetic::exact> z {arithmetic::add(x, y)}; z.has_value())
+            {
+                x = *z;
+                continue;
+            }
+            wide = arithmetic::widen(arithmetic::reduce(x));
+        }
+        wide = add(*wide, arithmetic::widen(y));
+    }
+    return wide ? *wide : arithmetic::widen(arithmetic::reduce(x));
+}
+
+// Pairwise, so that partial results of similar size meet first.
+template<typename T, typename F>
+T merge(std::vector<T> x, F op)
+{
+    for(std::size_t width {1}; width < x.size(); width *= 2)
+    {
+        for(std::size_t i {0}; i + width < x.size(); i += 2*width)
+        {
+            x[i] = op(x[i], x[i + width]);
+        }
+    }
+    return x.front();
+}
+
+// Runs f(i) for each chunk on its own thread.
+template<typename F>
+void parallel(std::size_t n, F f)
+{
+    std::vector<std::thread> workers {};
+    for(std::size_t i {1}; i < n; ++i)
+    {
+        workers.emplace_back(f, i);
+    }
+    f(0);
+    for(std::thread& w : workers)
+    {
+        w.join();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    for(int i {1}; i < argc; ++i)
+    {
+        std::string arg {argv[i]};
+        if(arg == "--stats")
+        {
+            opts.stats = true;
+        }
+        else if(arg.starts_with("--") && i + 1 < argc)
+        {
+            std::optional<unsigned long long> value {number(argv[++i])};
+            if(arg != "--threads" && arg != "--digits" && arg != "--max-denom")
+            {
+                std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+                return 2;
+            }
+            else if(!value || (arg != "--max-denom" && *value > std::numeric_limits<unsigned>::max()))
+            {
+                opts.op.clear();
+                break;
+            }
+            else if(arg == "--threads")
+            {
+                opts.threads = std::max(1u, static_cast<unsigned>(*value));
+            }
+            else if(arg == "--digits")
+            {
+                opts.digits = static_cast<unsigned>(*value);
+            }
+            else
+            {
+                opts.max_denom = std::max(1ull, *value);
+            }
+        }
+        else if(opts.op.empty() && !arg.starts_with("--"))
+        {
+            opts.op = arg;
+        }
+        else if(opts.path == "-" && !arg.starts_with("--"))
+        {
+            opts.path = arg;
+        }
+        else
+        {
+            opts.op.clear();
+            break;
+        }
+    }
+    const std::vector<std::string> ops {"sum", "min", "max", "sort", "decimal", "limit"};
+    if(std::find(ops.begin(), ops.end(), opts.op) == ops.end())
+    {
+        std::fprintf(stderr, "usage: fractool sum|min|max|sort|decimal|limit [FILE] [--threads K] [--digits N] "
+            "[--max-denom N] [--stats]\n");
+        return 2;
+    }
+
+    auto start {std::chrono::steady_clock::now()};
+    std::optional<sss::mapped_file> file {sss::mapped_file::open(opts.path == "-" ? "/dev/stdin" : opts.path)};
+    std::string buffer {};
+    std::string_view input {};
+    if(file && (file->get_size() > 0 || opts.path != "-"))
+    {
+        input = {reinterpret_cast<const char*>(file->get_data()), file->get_size()};
+    }
+    else if(opts.path == "-")
+    {
+        char block[1 << 16];
+        for(std::size_t n {}; (n = std::fread(block, 1, sizeof(block), stdin)) > 0;)
+        {
+            buffer.append(block, n);
+        }
+        input = buffer;
+    }
+    else
+    {
+        std::fprintf(stderr, "fractool: cannot open %s\n", opts.path.c_str());
+        return 1;
+    }
+
+    std::size_t threads {std::min<std::size_t>(opts.threads, input.size()/4096 + 1)};
+    std::vector<std::size_t> bounds {0};
+    for(std::size_t t {1}; t < threads; ++t)
+    {
+        std::size_t b {std::max(bounds.back(), input.size()*t/threads)};
+        std::size_t newline {input.find('\n', b)};
+        bounds.push_back(newline == std::string_view::npos ? input.size() : newline + 1);
+    }
+    bounds.push_back(input.size());
+    std::vector<chunk> chunks(threads);
+    bool sorting {opts.op == "sort"};
+    bool reducing {opts.op == "sum" || opts.op == "min" || opts.op == "max"};
+
+    // Each thread parses its own lines, and then either folds them into one partial result or formats them, so
+    // only sort has to come back together before anything is printed.
+    parallel(threads, [&](std::size_t t)
+    {
+        chunk& c {chunks[t]};
+        sss::clear_inexact();
+        std::size_t offset {bounds[t]};
+        while(offset < bounds[t + 1] && !c.error)
+        {
+            std::size_t end {std::min(input.find('\n', offset), bounds[t + 1])};
+            std::string_view line {input.substr(offset, end - offset)};
+            if(line.find_first_not_of(" \t\r") != std::string_view::npos)
+            {
+                std::optional<f> x {parse(line)};
+                if(!x)
+                {
+                    c.error = offset;
+                    break;
+                }
+                c.values.push_back(*x);
+            }
+            offset = end + 1;
+        }
+        c.count = c.values.size();
+        if(opts.op == "sum")
+        {
+            c.sum = sum(c.values, c.special);
+            c.values.clear();
+        }
+        else if(reducing && !c.values.empty())
+        {
+            f y {c.values.front()};
+            for(std::size_t i {1}; i < c.values.size(); ++i)
+            {
+                if(opts.op == "min" ? exact_less(c.values[i], y) : exact_less(y, c.values[i]))
+                {
+                    y = c.values[i];
+                }
+            }
+            c.values.assign(1, y);
+        }
+        else if(!sorting && !reducing)
+        {
+            for(const f& x : c.values)
+            {
+                c.out += opts.op == "decimal" ? decimal(x, opts.digits)
+                    : static_cast<std::string>(limit(x, opts.max_denom));
+                c.out += '\n';
+            }
+        }
+        c.inexact = sss::test_inexact();
+    });
+
+    std::size_t count {0};
+    std::vector<f> values {};
+    std::vector<arithmetic::wide_exact> sums {};
+    std::vector<f> specials {};
+    for(chunk& c : chunks)
+    {
+        if(c.error)
+        {
+            std::fprintf(stderr, "fractool: cannot parse the line at byte %zu\n", *c.error);
+            return 1;
+        }
+        count += c.count;
+        sums.push_back(c.sum);
+        specials.push_back(c.special);
+        if(reducing || sorting)
+        {
+            values.insert(values.end(), c.values.begin(), c.values.end());
+        }
+    }
+    bool inexact {false};
+    std::string out {};
+    if(opts.op == "sum")
+    {
+        sss::clear_inexact();
+        f special {merge(specials, [](const f& a, const f& b)
+        {
+            return a + b;
+        })};
+        out = static_cast<std::string>(special.is_finite() ? arithmetic::narrow(merge(sums, add)) : special) + '\n';
+        inexact = sss::test_inexact();
+    }
+    else if(reducing && !values.empty())
+    {
+        out = static_cast<std::string>(merge(values, [&opts](const f& a, const f& b)
+        {
+            return (opts.op == "min" ? exact_less(b, a) : exact_less(a, b)) ? b : a;
+        })) + '\n';
+    }
+    else if(sorting)
+    {
+        sss::parallel_sort(values, threads);
+        for(const f& x : values)
+        {
+            out += static_cast<std::string>(x);
+            out += '\n';
+        }
+    }
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    for(const chunk& c : chunks)
+    {
+        std::fwrite(c.out.data(), 1, c.out.size(), stdout);
+        inexact = inexact || c.inexact;
+    }
+    std::fflush(stdout);
+
+    if(inexact)
+    {
+        std::fprintf(stderr, "fractool: the result overflowed and was approximated\n");
+    }
+    if(opts.stats)
+    {
+        double seconds {std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+        std::fprintf(stderr, "%zu bytes, %zu values, %u threads, %.3f s, %.1f MB/s, %.0f values/s\n", input.size(),
+            count, static_cast<unsigned>(threads), seconds, static_cast<double>(input.size())/seconds/1e6,
+            static_cast<double>(count)/seconds);
+    }
+}
@@ -0,0 +1,528 @@
+#include "fused.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fma(const fraction<T>& a, const fraction<T>& b, const fraction<T>& c) noexcept
+    {
+        return fused_arithmetic<T>::fma(a, b, c);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> dot(std::span<const fraction<T>> a, std::span<const fraction<T>> b) noexcept
+    {
+        return fused_arithmetic<T>::dot(a, b);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fused_arithmetic<T>::fma(
+        const fraction<T>& a,
+        const fraction<T>& b,
+        const fraction<T>& c
+    ) noexcept
+    {
+        if(!a.is_finite() || !b.is_finite() || !c.is_finite())
+        {
+            return a*b + c;
+        }
+        exact x {a.get_numer(), a.get_denom()};
+        exact y {b.get_numer(), b.get_denom()};
+        exact z {c.get_numer(), c.get_denom()};
+        std::optional<exact> product {mul(x, y)};
+        std::optional<exact> sum {product ? add(*product, z) : std::nullopt};
+        if(sum)
+        {
+            return narrow(*sum);
+        }
+        return narrow(wide_add(wide_mul(widen(x), widen(y)), widen(z)));
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> fused_arithmetic<T>::dot(
+        std::span<const fraction<T>> a,
+        std::span<const fraction<T>> b
+    ) noexcept
+    {
+        std::size_t n {std::min(a.size(), b.size())};
+        for(std::size_t i {0}; i < n; ++i)
+        {
+            if(!a[i].is_finite() || !b[i].is_finite())
+            {
+                fraction<T> y {0};
+                for(std::size_t j {0}; j < n; ++j)
+                {
+                    y = y + a[j]*b[j];
+                }
+                return y;
+            }
+        }
+        exact x {0, 1};
+        std::size_t i {0};
+        for(; i < n; ++i)
+        {
+            std::optional<exact> y {try_mul(
+                {a[i].get_numer(), a[i].get_denom()},
+                {b[i].get_numer(), b[i].get_denom()}
+            )};
+            if(y)
+            {
+                y = try_add(x, *y);
+            }
+            if(!y)
+            {
+                break;
+            }
+            x = *y;
+        }
+        if(i == n)
+        {
+            return narrow(x);
+        }
+        wide_exact sum {widen(reduce(x))};
+        for(; i < n; ++i)
+        {
+            wide_exact y {wide_mul(
+                widen({a[i].get_numer(), a[i].get_denom()}),
+                widen({b[i].get_numer(), b[i].get_denom()})
+            )};
+            sum = wide_add(widen(shorten(sum)), y);
+        }
+        return narrow(sum);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::add(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        std::optional<exact> x {try_add(a, b)};
+        return x ? x : cancel_add(reduce(a), reduce(b));
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::sub(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        acc_t numer {};
+        if(__builtin_sub_overflow(acc_t{0}, b.numer, &numer))
+        {
+            return std::nullopt;
+        }
+        return add(a, {numer, b.denom});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::mul(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        std::optional<exact> x {try_mul(a, b)};
+        if(x)
+        {
+            return x;
+        }
+        exact c {reduce(a)};
+        exact d {reduce(b)};
+        acc_t g {static_cast<acc_t>(wide::gcd(magnitude(c.numer), static_cast<acc_magnitude_t>(d.denom)))};
+        acc_t h {static_cast<acc_t>(wide::gcd(magnitude(d.numer), static_cast<acc_magnitude_t>(c.denom)))};
+        return try_mul({c.numer/g, c.denom/h}, {d.numer/h, d.denom/g});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::div(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        if(b.numer == 0)
+        {
+            return std::nullopt;
+        }
+        if(b.numer > 0)
+        {
+            return mul(a, {b.denom, b.numer});
+        }
+        acc_t denom {};
+        if(__builtin_sub_overflow(acc_t{0}, b.numer, &denom))
+        {
+            return std::nullopt;
+        }
+        return mul(a, {-b.denom, denom});
+    }
+
+    // Neither operand is reduced. Over a common denominator, as in a dot product with fixed-point coefficients,
+    // this is a single addition; otherwise the sum moves to the least common denominator of the two rather than
+    // their product, so that it grows only as far as it must.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::try_add(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        exact x {};
+        if(a.denom == b.denom)
+        {
+            x.denom = a.denom;
+            if(__builtin_add_overflow(a.numer, b.numer, &x.numer))
+            {
+                return std::nullopt;
+            }
+            return x;
+        }
+        acc_t g {static_cast<acc_t>(
+            wide::gcd(static_cast<acc_magnitude_t>(a.denom), static_cast<acc_magnitude_t>(b.denom))
+        )};
+        acc_t lhs {};
+        acc_t rhs {};
+        if(
+            __builtin_mul_overflow(a.numer, b.denom/g, &lhs)
+            || __builtin_mul_overflow(b.numer, a.denom/g, &rhs)
+            || __builtin_add_overflow(lhs, rhs, &x.numer)
+            || __builtin_mul_overflow(a.denom, b.denom/g, &x.denom)
+        )
+        {
+            return std::nullopt;
+        }
+        return x;
+    }
+    // Both operands are reduced. The sum over the least common denominator can only share a factor with the gcd g
+    // of the two denominators, so that factor is cancelled before the denominator is formed, which then overflows
+    // only when the reduced sum would.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::cancel_add(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        acc_t g {static_cast<acc_t>(
+            wide::gcd(static_cast<acc_magnitude_t>(a.denom), static_cast<acc_magnitude_t>(b.denom))
+        )};
+        acc_t lhs {};
+        acc_t rhs {};
+        acc_t numer {};
+        if(
+            __builtin_mul_overflow(a.numer, b.denom/g, &lhs)
+            || __builtin_mul_overflow(b.numer, a.denom/g, &rhs)
+            || __builtin_add_overflow(lhs, rhs, &numer)
+        )
+        {
+            return std::nullopt;
+        }
+        acc_t h {static_cast<acc_t>(wide::gcd(magnitude(numer), static_cast<acc_magnitude_t>(g)))};
+        exact x {numer/h, 0};
+        if(__builtin_mul_overflow(a.denom/g, b.denom/h, &x.denom))
+        {
+            return std::nullopt;
+        }
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> fused_arithmetic<T>::try_mul(
+        const exact& a,
+        const exact& b
+    ) noexcept
+    {
+        exact x {};
+        if(__builtin_mul_overflow(a.numer, b.numer, &x.numer) || __builtin_mul_overflow(a.denom, b.denom, &x.denom))
+        {
+            return std::nullopt;
+        }
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::exact fused_arithmetic<T>::reduce(const exact& x) noexcept
+    {
+        acc_t g {static_cast<acc_t>(wide::gcd(magnitude(x.numer), static_cast<acc_magnitude_t>(x.denom)))};
+        return {x.numer/g, x.denom/g};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::wide_exact fused_arithmetic<T>::widen(const exact& x) noexcept
+    {
+        return {x.numer < 0, {0, magnitude(x.numer)}, {0, static_cast<acc_magnitude_t>(x.denom)}};
+    }
+    // As in cancel_add(), the sum over the least common denominator can only share a factor with the gcd g of the
+    // two denominators.
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::wide_exact fused_arithmetic<T>::wide_add(
+        const wide_exact& a,
+        const wide_exact& b
+    ) noexcept
+    {
+        wide::uint128_t g {wide::gcd(a.denom.low, b.denom.low)};
+        wide::uint256_t lhs {wide::mul_full(a.numer.low, b.denom.low/g)};
+        wide::uint256_t rhs {wide::mul_full(b.numer.low, a.denom.low/g)};
+        wide_exact x {};
+        if(a.negative == b.negative)
+        {
+            x.numer = wide::add_full(lhs, rhs);
+            x.negative = a.negative;
+        }
+        else
+        {
+            x.numer = lhs < rhs ? wide::sub_full(rhs, lhs) : wide::sub_full(lhs, rhs);
+            x.negative = lhs < rhs ? b.negative : a.negative;
+        }
+        if(x.numer == wide::uint256_t{0, 0})
+        {
+            return {false, {0, 0}, {0, 1}};
+        }
+        wide::uint128_t h {wide::gcd(wide::div_mod(x.numer, {0, g}).rem.low, g)};
+        x.numer = wide::div_mod(x.numer, {0, h}).quot;
+        x.denom = wide::mul_full(a.denom.low/g, b.denom.low/h);
+        return x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::wide_exact fused_arithmetic<T>::wide_sub(
+        const wide_exact& a,
+        const wide_exact& b
+    ) noexcept
+    {
+        return wide_add(a, {!b.negative, b.numer, b.denom});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::wide_exact fused_arithmetic<T>::wide_mul(
+        const wide_exact& a,
+        const wide_exact& b
+    ) noexcept
+    {
+        if(a.numer.low == 0 || b.numer.low == 0)
+        {
+            return {false, {0, 0}, {0, 1}};
+        }
+        wide::uint128_t g {wide::gcd(a.numer.low, b.denom.low)};
+        wide::uint128_t h {wide::gcd(b.numer.low, a.denom.low)};
+        return {
+            a.negative != b.negative,
+            wide::mul_full(a.numer.low/g, b.numer.low/h),
+            wide::mul_full(a.denom.low/h, b.denom.low/g)
+        };
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::wide_exact fused_arithmetic<T>::wide_div(
+        const wide_exact& a,
+        const wide_exact& b
+    ) noexcept
+    {
+        return wide_mul(a, {b.negative, b.denom, b.numer});
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::exact fused_arithmetic<T>::shorten(const wide_exact& x) noexcept
+    {
+        constexpr acc_magnitude_t max {static_cast<acc_magnitude_t>(std::numeric_limits<acc_t>::max())};
+        ratio r {};
+        if(x.numer.high == 0 && x.denom.high == 0 && x.numer.low <= max && x.denom.low <= max)
+        {
+            r = {static_cast<acc_magnitude_t>(x.numer.low), static_cast<acc_magnitude_t>(x.denom.low)};
+        }
+        else
+        {
+            raise_inexact();
+            r = closest(x.numer, x.denom, max, max);
+        }
+        acc_t numer {static_cast<acc_t>(r.numer)};
+        return {x.negative ? -numer : numer, static_cast<acc_t>(r.denom)};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::strong_ordering fused_arithmetic<T>::compare(const exact& a, const exact& b) noexcept
+    {
+        if((a.numer < 0) != (b.numer < 0) || a.numer == 0 || b.numer == 0)
+        {
+            return a.numer <=> b.numer;
+        }
+        acc_magnitude_t a_numer {magnitude(a.numer)};
+        acc_magnitude_t b_numer {magnitude(b.numer)};
+        acc_magnitude_t a_denom {static_cast<acc_magnitude_t>(a.denom)};
+        acc_magnitude_t b_denom {static_cast<acc_magnitude_t>(b.denom)};
+        bool a_less {less(a_numer, a_denom, b_numer, b_denom)};
+        if(a_less == less(b_numer, b_denom, a_numer, a_denom))
+        {
+            return std::strong_ordering::equal;
+        }
+        return a_less != (a.numer < 0) ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    template<
+        typename fused_arithmetic<T>::acc_magnitude_t MaxNumer,
+        typename fused_arithmetic<T>::acc_magnitude_t MaxDenom
+    >
+    constexpr fraction<T> fused_arithmetic<T>::narrow(const exact& x) noexcept
+    {
+        bool negative {x.numer < 0};
+        acc_magnitude_t numer {static_cast<acc_magnitude_t>(x.numer)};
+        if(negative)
+        {
+            numer = acc_magnitude_t{0} - numer;
+        }
+        acc_magnitude_t denom {static_cast<acc_magnitude_t>(x.denom)};
+        acc_magnitude_t g {wide::gcd(numer, denom)};
+        numer = wide::div_mod(numer, g).quot;
+        denom = wide::div_mod(denom, g).quot;
+        bool fits {negative ? std::is_signed_v<T> && numer <= MaxNumer + 1 : numer <= MaxNumer};
+        if(!fits || denom > MaxDenom)
+        {
+            raise_inexact();
+            return nearest<MaxNumer, MaxDenom>(negative, numer, denom);
+        }
+        magnitude_t m {static_cast<magnitude_t>(numer)};
+        if(negative)
+        {
+            m = static_cast<magnitude_t>(magnitude_t{0} - m);
+        }
+        return fraction<T>{reduced, static_cast<T>(m), static_cast<magnitude_t>(denom)};
+    }
+    template<typename T> requires nonbool_integral<T>
+    template<
+        typename fused_arithmetic<T>::acc_magnitude_t MaxNumer,
+        typename fused_arithmetic<T>::acc_magnitude_t MaxDenom
+    >
+    constexpr fraction<T> fused_arithmetic<T>::narrow(const wide_exact& x) noexcept
+    {
+        bool fits {x.numer.high == 0 && x.denom.high == 0 && x.denom.low <= MaxDenom && (x.negative
+            ? std::is_signed_v<T> && x.numer.low <= wide::uint128_t{MaxNumer} + 1
+            : x.numer.low <= MaxNumer
+        )};
+        if(!fits)
+        {
+            raise_inexact();
+            return nearest<MaxNumer, MaxDenom>(x.negative, x.numer, x.denom);
+        }
+        magnitude_t m {static_cast<magnitude_t>(x.numer.low)};
+        if(x.negative)
+        {
+            m = static_cast<magnitude_t>(magnitude_t{0} - m);
+        }
+        return fraction<T>{reduced, static_cast<T>(m), static_cast<magnitude_t>(x.denom.low)};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    template<
+        typename fused_arithmetic<T>::acc_magnitude_t MaxNumer,
+        typename fused_arithmetic<T>::acc_magnitude_t MaxDenom,
+        typename U
+    >
+    constexpr fraction<T> fused_arithmetic<T>::nearest(bool negative, U numer, U denom) noexcept
+    {
+        if(negative && !std::is_signed_v<T>)
+        {
+            return fraction<T>{0};
+        }
+        ratio r {closest(numer, denom, MaxNumer + (negative && std::is_signed_v<T>), MaxDenom)};
+        magnitude_t m {static_cast<magnitude_t>(r.numer)};
+        if(negative)
+        {
+            m = static_cast<magnitude_t>(magnitude_t{0} - m);
+        }
+        return fraction<T>{reduced, static_cast<T>(m), static_cast<magnitude_t>(r.denom)};
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename fused_arithmetic<T>::acc_magnitude_t fused_arithmetic<T>::magnitude(acc_t x) noexcept
+    {
+        acc_magnitude_t m {static_cast<acc_magnitude_t>(x)};
+        return x < 0 ? acc_magnitude_t{0} - m : m;
+    }
+    // Walks the continued fraction of numer/denom like fraction_interval's outward rounding, but picks whichever of
+    // the two closest fractions in range is nearer. With a the partial quotient that no longer fits, t the largest
+    // multiple of the last convergent that still does, and r/denom the rest of the value, the convergent is at
+    // least as near exactly when a + r/denom >= 2t + q0/q1, which is decided from a alone unless a == 2t.
+    template<typename T> requires nonbool_integral<T>
+    template<typename U>
+    constexpr typename fused_arithmetic<T>::ratio fused_arithmetic<T>::closest(
+        U numer,
+        U denom,
+        acc_magnitude_t max_numer,
+        acc_magnitude_t max_denom
+    ) noexcept
+    {
+        acc_magnitude_t p0 {0};
+        acc_magnitude_t q0 {1};
+        acc_magnitude_t p1 {1};
+        acc_magnitude_t q1 {0};
+        acc_magnitude_t p {0};
+        acc_magnitude_t q {1};
+        for(;;)
+        {
+            wide::quotient<U> step {wide::div_mod(numer, denom)};
+            acc_magnitude_t a {saturate(step.quot)};
+            U r {step.rem};
+            acc_magnitude_t t {a};
+            if(p1 != 0)
+            {
+                t = std::min(t, wide::div_mod(max_numer - p0, p1).quot);
+            }
+            if(q1 != 0)
+            {
+                t = std::min(t, wide::div_mod(max_denom - q0, q1).quot);
+            }
+            if(t < a)
+            {
+                bool convergent {q1 != 0 && (a > 2*t || (a == 2*t && !less(r, denom, q0, q1)))};
+                p = convergent ? p1 : t*p1 + p0;
+                q = convergent ? q1 : t*q1 + q0;
+                break;
+            }
+            p = a*p1 + p0;
+            q = a*q1 + q0;
+            if(saturate(r) == 0)
+            {
+                break;
+            }
+            p0 = p1;
+            q0 = q1;
+            p1 = p;
+            q1 = q;
+            numer = denom;
+            denom = r;
+        }
+        return {p, q};
+    }
+    template<typename T> requires nonbool_integral<T>
+    template<typename U>
+    constexpr typename fused_arithmetic<T>::acc_magnitude_t fused_arithmetic<T>::saturate(const U& x) noexcept
+    {
+        if constexpr(std::same_as<U, acc_magnitude_t>)
+        {
+            return x;
+        }
+        else
+        {
+            constexpr acc_magnitude_t max {std::numeric_limits<acc_magnitude_t>::max()};
+            return x.high != 0 || x.low > max ? max : static_cast<acc_magnitude_t>(x.low);
+        }
+    }
+    // Compares a_numer/a_denom with b_numer/b_denom through their continued fractions, so no product can overflow.
+    // A partial quotient of the a side too wide for the accumulator can only be the larger, since those of the b
+    // side fit.
+    template<typename T> requires nonbool_integral<T>
+    template<typename U>
+    constexpr bool fused_arithmetic<T>::less(
+        U a_numer,
+        U a_denom,
+        acc_magnitude_t b_numer,
+        acc_magnitude_t b_denom
+    ) noexcept
+    {
+        for(bool flipped {false};; flipped = !flipped)
+        {
+            wide::quotient<U> a {wide::div_mod(a_numer, a_denom)};
+            wide::quotient<acc_magnitude_t> b {wide::div_mod(b_numer, b_denom)};
+            acc_magnitude_t a_quot {saturate(a.quot)};
+            if(a_quot != b.quot)
+            {
+                return (a_quot < b.quot) != flipped;
+            }
+            bool a_exhausted {saturate(a.rem) == 0};
+            bool b_exhausted {b.rem == 0};
+            if(a_exhausted || b_exhausted)
+            {
+                return a_exhausted != b_exhausted && a_exhausted != flipped;
+            }
+            a_numer = a_denom;
+            a_denom = a.rem;
+            b_numer = b_denom;
+            b_denom = b.rem;
+        }
+    }
+}
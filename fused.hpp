@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "status.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // a*b + c with one reduction at the end instead of one per operator. The exact result is formed in a 64-bit
+    // accumulator, or a 128-bit one for 32- and 64-bit T, or in 256 bits when it does not fit there, which for
+    // fraction<long long> is whenever the denominators are much above 2^42. It is only approximated when it does not
+    // fit in fraction<T>, and then by the nearest fraction that does, raising the inexact flag. Infinities and NaN
+    // go through the ordinary operators instead.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr fraction<T> fma(const fraction<T>& a, const fraction<T>& b, const fraction<T>& c) noexcept;
+
+    // The sum of a[i]*b[i] over the shorter of the two spans, exact until the single reduction at the end, with the
+    // same fallbacks as fma(). Terms over the same denominator as the running sum, as with fixed-point filter
+    // coefficients, cost one multiply and one add each. Once the sum outgrows the accumulator each term is added
+    // in 256 bits, and a running sum too wide to go on from is rounded to the nearest value the accumulator holds,
+    // far finer than fraction<T>, raising the inexact flag.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr fraction<T> dot(std::span<const fraction<T>> a, std::span<const fraction<T>> b) noexcept;
+
+    // Exact arithmetic on unreduced values in the wide accumulator, shared by fma(), dot() and the lazy expressions.
+    template<typename T> requires nonbool_integral<T>
+    class fused_arithmetic
+    {
+        public:
+            using acc_t = std::conditional_t<sizeof(T) <= 2, std::int64_t, wide::int128_t>;
+
+            // An unreduced exact value with a positive denominator.
+            struct exact
+            {
+                acc_t numer;
+                acc_t denom;
+            };
+
+            [[nodiscard]] static constexpr fraction<T> fma(
+                const fraction<T>& a,
+                const fraction<T>& b,
+                const fraction<T>& c
+            ) noexcept;
+            [[nodiscard]] static constexpr fraction<T> dot(
+                std::span<const fraction<T>> a,
+                std::span<const fraction<T>> b
+            ) noexcept;
+
+            // The operations give nothing when the reduced result does not fit in the accumulator, or for add and sub
+            // when the numerator over the least common denominator does not, and div also when the divisor is zero.
+            [[nodiscard]] static constexpr std::optional<exact> add(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr std::optional<exact> sub(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr std::optional<exact> mul(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr std::optional<exact> div(const exact& a, const exact& b) noexcept;
+            // x with its numerator and denominator divided by their gcd.
+            [[nodiscard]] static constexpr exact reduce(const exact& x) noexcept;
+
+            // A value too wide for the accumulator, as its sign and 256-bit magnitudes.
+            struct wide_exact
+            {
+                bool negative;
+                wide::uint256_t numer;
+                wide::uint256_t denom;
+            };
+
+            [[nodiscard]] static constexpr wide_exact widen(const exact& x) noexcept;
+            // The reduced results of operations on reduced values of at most 128 bits, formed exactly in 256 bits
+            // with the operands cancelled against each other first. div needs a nonzero divisor.
+            [[nodiscard]] static constexpr wide_exact wide_add(const wide_exact& a, const wide_exact& b) noexcept;
+            [[nodiscard]] static constexpr wide_exact wide_sub(const wide_exact& a, const wide_exact& b) noexcept;
+            [[nodiscard]] static constexpr wide_exact wide_mul(const wide_exact& a, const wide_exact& b) noexcept;
+            [[nodiscard]] static constexpr wide_exact wide_div(const wide_exact& a, const wide_exact& b) noexcept;
+            // x in the accumulator, or the nearest value the accumulator holds, raising the inexact flag, when it
+            // does not fit.
+            [[nodiscard]] static constexpr exact shorten(const wide_exact& x) noexcept;
+            // The order of a and b, without multiplying them out.
+            [[nodiscard]] static constexpr std::strong_ordering compare(const exact& a, const exact& b) noexcept;
+            using acc_magnitude_t = std::conditional_t<sizeof(T) <= 2, std::uint64_t, wide::uint128_t>;
+
+            // x reduced, or the nearest fraction<T> to it, raising the inexact flag, when that does not fit. Narrower
+            // bounds, such as those of a packed_fraction, can be given instead of T's: a numerator of at most
+            // MaxNumer, or MaxNumer + 1 below zero, and a denominator of at most MaxDenom. Both must fit in T. A
+            // negative x gives 0 for unsigned T.
+            template<
+                acc_magnitude_t MaxNumer = static_cast<acc_magnitude_t>(std::numeric_limits<T>::max()),
+                acc_magnitude_t MaxDenom = acc_magnitude_t{std::numeric_limits<std::make_unsigned_t<T>>::max()}
+            >
+            [[nodiscard]] static constexpr fraction<T> narrow(const exact& x) noexcept;
+            template<
+                acc_magnitude_t MaxNumer = static_cast<acc_magnitude_t>(std::numeric_limits<T>::max()),
+                acc_magnitude_t MaxDenom = acc_magnitude_t{std::numeric_limits<std::make_unsigned_t<T>>::max()}
+            >
+            [[nodiscard]] static constexpr fraction<T> narrow(const wide_exact& x) noexcept;
+            // The nearest fraction<T> within the same bounds to numer/denom, negated when negative, which is
+            // numer/denom itself when that fits. U is acc_magnitude_t, or wide::uint256_t for a value too wide for the
+            // accumulator.
+            template<
+                acc_magnitude_t MaxNumer = static_cast<acc_magnitude_t>(std::numeric_limits<T>::max()),
+                acc_magnitude_t MaxDenom = acc_magnitude_t{std::numeric_limits<std::make_unsigned_t<T>>::max()},
+                typename U
+            >
+            [[nodiscard]] static constexpr fraction<T> nearest(bool negative, U numer, U denom) noexcept;
+
+        private:
+            using magnitude_t = std::make_unsigned_t<T>;
+
+            struct ratio
+            {
+                acc_magnitude_t numer;
+                acc_magnitude_t denom;
+            };
+
+            [[nodiscard]] static constexpr std::optional<exact> try_add(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr std::optional<exact> cancel_add(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr std::optional<exact> try_mul(const exact& a, const exact& b) noexcept;
+            [[nodiscard]] static constexpr acc_magnitude_t magnitude(acc_t x) noexcept;
+            // The nearest fraction to numer/denom with a numerator of at most max_numer and a denominator of at most
+            // max_denom.
+            template<typename U>
+            [[nodiscard]] static constexpr ratio closest(
+                U numer,
+                U denom,
+                acc_magnitude_t max_numer,
+                acc_magnitude_t max_denom
+            ) noexcept;
+            // x, or the largest acc_magnitude_t when x is wider.
+            template<typename U>
+            [[nodiscard]] static constexpr acc_magnitude_t saturate(const U& x) noexcept;
+            template<typename U>
+            [[nodiscard]] static constexpr bool less(
+                U a_numer,
+                U a_denom,
+                acc_magnitude_t b_numer,
+                acc_magnitude_t b_denom
+            ) noexcept;
+    };
+}
+
+#include "fused.cpp"
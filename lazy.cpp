@@ -0,0 +1,249 @@
+#include "lazy.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr lazy_leaf<T>::lazy_leaf(const fraction<T>& x) noexcept:
+        x{x}
+    {
+
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::exact> lazy_leaf<T>::exact(void) const noexcept
+    {
+        if(!this->x.is_finite())
+        {
+            return std::nullopt;
+        }
+        return typename fused_arithmetic<T>::exact{this->x.get_numer(), this->x.get_denom()};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename fused_arithmetic<T>::wide_exact> lazy_leaf<T>::widened(void) const noexcept
+    {
+        std::optional<typename fused_arithmetic<T>::exact> x {this->exact()};
+        if(!x)
+        {
+            return std::nullopt;
+        }
+        return fused_arithmetic<T>::widen(*x);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr fraction<T> lazy_leaf<T>::eager(void) const noexcept
+    {
+        return this->x;
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr lazy_leaf<T>::operator fraction<T>(void) const noexcept
+    {
+        return this->x;
+    }
+
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<Op, L, R>::lazy_node(const L& lhs, const R& rhs) noexcept:
+        lhs{lhs},
+        rhs{rhs}
+    {
+
+    }
+    // The operands are evaluated left to right, and the first one that has to be evaluated eagerly makes the whole
+    // expression be.
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    constexpr std::optional<typename fused_arithmetic<typename L::value_type>::exact> lazy_node<Op, L, R>::exact(
+        void
+    ) const noexcept
+    {
+        using arithmetic = fused_arithmetic<value_type>;
+        std::optional<typename arithmetic::exact> a {this->lhs.exact()};
+        if(!a)
+        {
+            return std::nullopt;
+        }
+        std::optional<typename arithmetic::exact> b {this->rhs.exact()};
+        if(!b)
+        {
+            return std::nullopt;
+        }
+        if constexpr(Op == lazy_op::add)
+        {
+            return arithmetic::add(*a, *b);
+        }
+        else if constexpr(Op == lazy_op::sub)
+        {
+            return arithmetic::sub(*a, *b);
+        }
+        else if constexpr(Op == lazy_op::mul)
+        {
+            return arithmetic::mul(*a, *b);
+        }
+        else
+        {
+            return arithmetic::div(*a, *b);
+        }
+    }
+    // Each operand is rounded to the accumulator first, as the wide operations need, which only loses anything when
+    // the operand itself outgrew it.
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    constexpr std::optional<typename fused_arithmetic<typename L::value_type>::wide_exact> lazy_node<Op, L, R>::widened(
+        void
+    ) const noexcept
+    {
+        using arithmetic = fused_arithmetic<value_type>;
+        std::optional<typename arithmetic::wide_exact> a {this->lhs.widened()};
+        if(!a)
+        {
+            return std::nullopt;
+        }
+        std::optional<typename arithmetic::wide_exact> b {this->rhs.widened()};
+        if(!b)
+        {
+            return std::nullopt;
+        }
+        typename arithmetic::wide_exact x {arithmetic::widen(arithmetic::shorten(*a))};
+        typename arithmetic::wide_exact y {arithmetic::widen(arithmetic::shorten(*b))};
+        if constexpr(Op == lazy_op::add)
+        {
+            return arithmetic::wide_add(x, y);
+        }
+        else if constexpr(Op == lazy_op::sub)
+        {
+            return arithmetic::wide_sub(x, y);
+        }
+        else if constexpr(Op == lazy_op::mul)
+        {
+            return arithmetic::wide_mul(x, y);
+        }
+        else
+        {
+            if(y.numer == wide::uint256_t{})
+            {
+                return std::nullopt;
+            }
+            return arithmetic::wide_div(x, y);
+        }
+    }
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    constexpr fraction<typename L::value_type> lazy_node<Op, L, R>::eager(void) const noexcept
+    {
+        if constexpr(Op == lazy_op::add)
+        {
+            return this->lhs.eager() + this->rhs.eager();
+        }
+        else if constexpr(Op == lazy_op::sub)
+        {
+            return this->lhs.eager() - this->rhs.eager();
+        }
+        else if constexpr(Op == lazy_op::mul)
+        {
+            return this->lhs.eager()*this->rhs.eager();
+        }
+        else
+        {
+            return this->lhs.eager()/this->rhs.eager();
+        }
+    }
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<Op, L, R>::operator fraction<typename L::value_type>(void) const noexcept
+    {
+        using arithmetic = fused_arithmetic<value_type>;
+        if(std::optional<typename arithmetic::exact> x {this->exact()}; x.has_value())
+        {
+            return arithmetic::narrow(*x);
+        }
+        std::optional<typename arithmetic::wide_exact> x {this->widened()};
+        return x ? arithmetic::narrow(*x) : this->eager();
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr lazy_leaf<T> lazy(const fraction<T>& x) noexcept
+    {
+        return lazy_leaf<T>{x};
+    }
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<lazy_op::add, L, R> operator+(const L& lhs, const R& rhs) noexcept
+    {
+        return {lhs, rhs};
+    }
+    template<typename L> requires lazy_expression<L>
+    constexpr lazy_node<lazy_op::add, L, lazy_leaf<typename L::value_type>> operator+(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept
+    {
+        return {lhs, lazy_leaf<typename L::value_type>{rhs}};
+    }
+    template<typename R> requires lazy_expression<R>
+    constexpr lazy_node<lazy_op::add, lazy_leaf<typename R::value_type>, R> operator+(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept
+    {
+        return {lazy_leaf<typename R::value_type>{lhs}, rhs};
+    }
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<lazy_op::sub, L, R> operator-(const L& lhs, const R& rhs) noexcept
+    {
+        return {lhs, rhs};
+    }
+    template<typename L> requires lazy_expression<L>
+    constexpr lazy_node<lazy_op::sub, L, lazy_leaf<typename L::value_type>> operator-(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept
+    {
+        return {lhs, lazy_leaf<typename L::value_type>{rhs}};
+    }
+    template<typename R> requires lazy_expression<R>
+    constexpr lazy_node<lazy_op::sub, lazy_leaf<typename R::value_type>, R> operator-(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept
+    {
+        return {lazy_leaf<typename R::value_type>{lhs}, rhs};
+    }
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<lazy_op::mul, L, R> operator*(const L& lhs, const R& rhs) noexcept
+    {
+        return {lhs, rhs};
+    }
+    template<typename L> requires lazy_expression<L>
+    constexpr lazy_node<lazy_op::mul, L, lazy_leaf<typename L::value_type>> operator*(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept
+    {
+        return {lhs, lazy_leaf<typename L::value_type>{rhs}};
+    }
+    template<typename R> requires lazy_expression<R>
+    constexpr lazy_node<lazy_op::mul, lazy_leaf<typename R::value_type>, R> operator*(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept
+    {
+        return {lazy_leaf<typename R::value_type>{lhs}, rhs};
+    }
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    constexpr lazy_node<lazy_op::div, L, R> operator/(const L& lhs, const R& rhs) noexcept
+    {
+        return {lhs, rhs};
+    }
+    template<typename L> requires lazy_expression<L>
+    constexpr lazy_node<lazy_op::div, L, lazy_leaf<typename L::value_type>> operator/(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept
+    {
+        return {lhs, lazy_leaf<typename L::value_type>{rhs}};
+    }
+    template<typename R> requires lazy_expression<R>
+    constexpr lazy_node<lazy_op::div, lazy_leaf<typename R::value_type>, R> operator/(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept
+    {
+        return {lazy_leaf<typename R::value_type>{lhs}, rhs};
+    }
+}
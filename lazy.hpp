@@ -0,0 +1,143 @@
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "fused.hpp"
+
+namespace sss
+{
+    // Opt-in expression templates: lazy(a) + b builds the tree of an expression, with its operands copied in, and
+    // nothing is computed until it is converted to fraction<T>. The whole tree is then evaluated exactly in the
+    // accumulator of fused_arithmetic and reduced once, so there are no temporaries, no gcd per operator, and no
+    // approximation unless the final value does not fit. A tree that outgrows the accumulator is evaluated again in
+    // 256 bits, each subexpression rounded to the nearest value the accumulator holds, and the result rounded once to
+    // the nearest fraction<T>. Infinities, NaN and division by zero are evaluated with the ordinary operators
+    // instead, one step at a time.
+    enum class lazy_op
+    {
+        add,
+        sub,
+        mul,
+        div
+    };
+
+    template<typename E>
+    concept lazy_expression = requires(const E& e)
+    {
+        typename E::value_type;
+        { e.exact() } -> std::same_as<std::optional<typename fused_arithmetic<typename E::value_type>::exact>>;
+        { e.widened() } -> std::same_as<
+            std::optional<typename fused_arithmetic<typename E::value_type>::wide_exact>
+        >;
+        { e.eager() } -> std::same_as<fraction<typename E::value_type>>;
+    };
+
+    template<typename L, typename R>
+    concept lazy_operands = lazy_expression<L> && lazy_expression<R>
+        && std::same_as<typename L::value_type, typename R::value_type>;
+
+    template<typename T> requires nonbool_integral<T>
+    class lazy_leaf
+    {
+        private:
+            fraction<T> x;
+
+        public:
+            using value_type = T;
+
+            constexpr explicit lazy_leaf(const fraction<T>& x) noexcept;
+
+            // The value in the accumulator, or nothing when the expression has to be evaluated eagerly.
+            [[nodiscard]] constexpr std::optional<typename fused_arithmetic<T>::exact> exact(void) const noexcept;
+            // The value in 256 bits, for when exact() overflows, or nothing when it has to be evaluated eagerly.
+            [[nodiscard]] constexpr std::optional<typename fused_arithmetic<T>::wide_exact> widened(
+                void
+            ) const noexcept;
+            // The value computed with fraction's operators.
+            [[nodiscard]] constexpr fraction<T> eager(void) const noexcept;
+            [[nodiscard]] constexpr operator fraction<T>(void) const noexcept;
+    };
+
+    template<lazy_op Op, typename L, typename R> requires lazy_operands<L, R>
+    class lazy_node
+    {
+        private:
+            L lhs;
+            R rhs;
+
+        public:
+            using value_type = typename L::value_type;
+
+            constexpr lazy_node(const L& lhs, const R& rhs) noexcept;
+
+            [[nodiscard]] constexpr std::optional<typename fused_arithmetic<value_type>::exact> exact(
+                void
+            ) const noexcept;
+            [[nodiscard]] constexpr std::optional<typename fused_arithmetic<value_type>::wide_exact> widened(
+                void
+            ) const noexcept;
+            [[nodiscard]] constexpr fraction<value_type> eager(void) const noexcept;
+            [[nodiscard]] constexpr operator fraction<value_type>(void) const noexcept;
+    };
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr lazy_leaf<T> lazy(const fraction<T>& x) noexcept;
+
+    // Either operand may also be a plain fraction, or anything that converts to one, such as an integer.
+    template<typename L, typename R> requires lazy_operands<L, R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::add, L, R> operator+(const L& lhs, const R& rhs) noexcept;
+    template<typename L> requires lazy_expression<L>
+    [[nodiscard]] constexpr lazy_node<lazy_op::add, L, lazy_leaf<typename L::value_type>> operator+(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept;
+    template<typename R> requires lazy_expression<R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::add, lazy_leaf<typename R::value_type>, R> operator+(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept;
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::sub, L, R> operator-(const L& lhs, const R& rhs) noexcept;
+    template<typename L> requires lazy_expression<L>
+    [[nodiscard]] constexpr lazy_node<lazy_op::sub, L, lazy_leaf<typename L::value_type>> operator-(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept;
+    template<typename R> requires lazy_expression<R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::sub, lazy_leaf<typename R::value_type>, R> operator-(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept;
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::mul, L, R> operator*(const L& lhs, const R& rhs) noexcept;
+    template<typename L> requires lazy_expression<L>
+    [[nodiscard]] constexpr lazy_node<lazy_op::mul, L, lazy_leaf<typename L::value_type>> operator*(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept;
+    template<typename R> requires lazy_expression<R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::mul, lazy_leaf<typename R::value_type>, R> operator*(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept;
+
+    template<typename L, typename R> requires lazy_operands<L, R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::div, L, R> operator/(const L& lhs, const R& rhs) noexcept;
+    template<typename L> requires lazy_expression<L>
+    [[nodiscard]] constexpr lazy_node<lazy_op::div, L, lazy_leaf<typename L::value_type>> operator/(
+        const L& lhs,
+        const fraction<typename L::value_type>& rhs
+    ) noexcept;
+    template<typename R> requires lazy_expression<R>
+    [[nodiscard]] constexpr lazy_node<lazy_op::div, lazy_leaf<typename R::value_type>, R> operator/(
+        const fraction<typename R::value_type>& lhs,
+        const R& rhs
+    ) noexcept;
+}
+
+#include "lazy.cpp"
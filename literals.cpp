@@ -0,0 +1,195 @@
+#include "literals.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include "cia.hpp"
+
+namespace sss
+{
+    template<std::size_t N>
+    consteval fraction_string<N>::fraction_string(const char (&value)[N]) noexcept
+    {
+        std::copy_n(value, N, this->value);
+    }
+
+    template<std::size_t N>
+    consteval std::string_view fraction_string<N>::view(void) const noexcept
+    {
+        return {this->value, N - 1};
+    }
+
+    inline void fraction_literal_syntax_error(void) noexcept
+    {
+
+    }
+    inline void fraction_literal_overflow(void) noexcept
+    {
+
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    consteval fraction<T> parse_fraction_literal(std::string_view s) noexcept
+    {
+        auto is_digit = [](char c) -> bool
+        {
+            return c >= '0' && c <= '9';
+        };
+        auto push_digit = [](std::uintmax_t x, char c) -> std::uintmax_t
+        {
+            std::optional<std::uintmax_t> y {cia::checked_mul<std::uintmax_t>(x, 10)};
+            if(y.has_value())
+            {
+                y = cia::checked_add<std::uintmax_t>(y.value(), static_cast<std::uintmax_t>(c - '0'));
+            }
+            if(!y.has_value())
+            {
+                fraction_literal_overflow();
+            }
+            return y.value();
+        };
+
+        std::size_t i {0};
+        bool negative {false};
+        if(i < s.size() && (s[i] == '-' || s[i] == '+'))
+        {
+            negative = s[i] == '-';
+            ++i;
+        }
+
+        std::uintmax_t numer {0};
+        std::uintmax_t denom {1};
+        std::size_t digits {0};
+        for(; i < s.size() && is_digit(s[i]); ++i, ++digits)
+        {
+            numer = push_digit(numer, s[i]);
+        }
+        if(i < s.size() && s[i] == '.')
+        {
+            std::size_t end {++i};
+            while(end < s.size() && is_digit(s[end]))
+            {
+                ++end;
+            }
+            std::size_t last {end};
+            while(last > i && s[last - 1] == '0')
+            {
+                --last;
+            }
+            digits += end - i;
+            for(; i < last; ++i)
+            {
+                numer = push_digit(numer, s[i]);
+                denom = push_digit(denom, '0');
+            }
+            i = end;
+        }
+        if(digits == 0)
+        {
+            fraction_literal_syntax_error();
+        }
+        if(i < s.size() && s[i] == '/')
+        {
+            std::uintmax_t d {0};
+            for(digits = 0, ++i; i < s.size() && is_digit(s[i]); ++i, ++digits)
+            {
+                d = push_digit(d, s[i]);
+            }
+            if(digits == 0)
+            {
+                fraction_literal_syntax_error();
+            }
+            std::optional<std::uintmax_t> y {cia::checked_mul<std::uintmax_t>(denom, d)};
+            if(!y.has_value())
+            {
+                fraction_literal_overflow();
+            }
+            denom = y.value();
+        }
+        if(i != s.size())
+        {
+            fraction_literal_syntax_error();
+        }
+
+        std::uintmax_t gcd {std::gcd(numer, denom)};
+        if(gcd != 0 && gcd != 1)
+        {
+            numer /= gcd;
+            denom /= gcd;
+        }
+        if(denom > std::numeric_limits<std::make_unsigned_t<T>>::max())
+        {
+            fraction_literal_overflow();
+        }
+        if(negative && numer != 0)
+        {
+            if(!std::is_signed<T>::value || numer - 1 > static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+            {
+                fraction_literal_overflow();
+            }
+            return fraction<T>{
+                reduced,
+                static_cast<T>(T(-1) - static_cast<T>(numer - 1)),
+                static_cast<std::make_unsigned_t<T>>(denom)
+            };
+        }
+        if(numer > static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+        {
+            fraction_literal_overflow();
+        }
+        return fraction<T>{reduced, static_cast<T>(numer), static_cast<std::make_unsigned_t<T>>(denom)};
+    }
+
+    inline namespace literals
+    {
+        template<fraction_string S>
+        consteval fraction<int> operator""_fr(void) noexcept
+        {
+            return parse_fraction_literal<int>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::int8_t> operator""_fr8(void) noexcept
+        {
+            return parse_fraction_literal<std::int8_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::int16_t> operator""_fr16(void) noexcept
+        {
+            return parse_fraction_literal<std::int16_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::int32_t> operator""_fr32(void) noexcept
+        {
+            return parse_fraction_literal<std::int32_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::int64_t> operator""_fr64(void) noexcept
+        {
+            return parse_fraction_literal<std::int64_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<unsigned int> operator""_ufr(void) noexcept
+        {
+            return parse_fraction_literal<unsigned int>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::uint8_t> operator""_ufr8(void) noexcept
+        {
+            return parse_fraction_literal<std::uint8_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::uint16_t> operator""_ufr16(void) noexcept
+        {
+            return parse_fraction_literal<std::uint16_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::uint32_t> operator""_ufr32(void) noexcept
+        {
+            return parse_fraction_literal<std::uint32_t>(S.view());
+        }
+        template<fraction_string S>
+        consteval fraction<std::uint64_t> operator""_ufr64(void) noexcept
+        {
+            return parse_fraction_literal<std::uint64_t>(S.view());
+        }
+    }
+}
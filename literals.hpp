@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "fraction.hpp"
+
+namespace sss
+{
+    template<std::size_t N>
+    struct fraction_string
+    {
+        char value[N];
+
+        consteval fraction_string(const char (&value)[N]) noexcept;
+
+        [[nodiscard]] consteval std::string_view view(void) const noexcept;
+    };
+
+    // Literals are parsed and reduced during constant evaluation; malformed or unrepresentable input fails to compile
+    // with a call to fraction_literal_syntax_error() or fraction_literal_overflow().
+    void fraction_literal_syntax_error(void) noexcept;
+    void fraction_literal_overflow(void) noexcept;
+
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] consteval fraction<T> parse_fraction_literal(std::string_view s) noexcept;
+
+    inline namespace literals
+    {
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<int> operator""_fr(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::int8_t> operator""_fr8(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::int16_t> operator""_fr16(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::int32_t> operator""_fr32(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::int64_t> operator""_fr64(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<unsigned int> operator""_ufr(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::uint8_t> operator""_ufr8(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::uint16_t> operator""_ufr16(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::uint32_t> operator""_ufr32(void) noexcept;
+        template<fraction_string S>
+        [[nodiscard]] consteval fraction<std::uint64_t> operator""_ufr64(void) noexcept;
+    }
+}
+
+#include "literals.cpp"
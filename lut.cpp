@@ -0,0 +1,33 @@
+#include "lut.hpp"
+
+#include <algorithm>
+
+namespace sss
+{
+    namespace lut
+    {
+        // Lower triangle only: gcd(a, b) for b <= a lives at a*(a + 1)/2 + b, which keeps the table at 32 KiB.
+        template<typename = void>
+        inline constexpr std::array<std::uint8_t, 256*257/2> gcd8 {[]()
+        {
+            std::array<std::uint8_t, 256*257/2> t {};
+            std::uint8_t* base {t.data()};
+            std::uint8_t* x {t.data()};
+            for(unsigned a {0}; a < 256; ++a)
+            {
+                for(unsigned b {0}; b <= a; ++b, ++x)
+                {
+                    *x = b == 0 ? static_cast<std::uint8_t>(a) : base[b*(b + 1)/2 + a % b];
+                }
+            }
+            return t;
+        }()};
+
+        constexpr std::uint8_t gcd(std::uint8_t a, std::uint8_t b) noexcept
+        {
+            unsigned hi {std::max(a, b)};
+            unsigned lo {std::min(a, b)};
+            return gcd8<>[hi*(hi + 1)/2 + lo];
+        }
+    }
+}
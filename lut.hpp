@@ -0,0 +1,16 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace sss
+{
+    namespace lut
+    {
+        // Table lookup of std::gcd(a, b) over every pair of 8-bit magnitudes. The table is built during
+        // constant evaluation, so this is usable in constant expressions as well.
+        [[nodiscard]] constexpr std::uint8_t gcd(std::uint8_t a, std::uint8_t b) noexcept;
+    }
+}
+
+#include "lut.cpp"
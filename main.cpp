@@ -1,6 +1,28 @@
+#include <atomic>
 #include <iostream>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
 
+#include "adaptive_fraction.hpp"
+#include "atomic_fraction.hpp"
+#include "continued_fraction.hpp"
+#include "farey.hpp"
+#include "fixed_fraction.hpp"
 #include "fraction.hpp"
+#include "fraction_file.hpp"
+#include "fraction_interval.hpp"
+#include "fused.hpp"
+#include "lazy.hpp"
+#include "literals.hpp"
+#include "lut.hpp"
+#include "packed_fraction.hpp"
+#include "rescale.hpp"
+#include "sharded_fraction_sum.hpp"
+#include "sort.hpp"
+#include "stats.hpp"
+#include "status.hpp"
 
 template<typename A, typename B>
 void assert_eq(const A& a, const B& b)
@@ -70,6 +92,23 @@ void test()
     {
         assert_eq(sss::fraction<T>{4, 3}.pow(3), sss::fraction<T>{64, 27});
     }
+    assert_eq(sss::fraction<T>{4, 3}.pow(0), 1);
+    assert_eq(sss::fraction<T>{4, 3}.pow(-2), sss::fraction<T>{9, 16});
+    assert_eq(sss::fraction<T>{0}.pow(-1).is_infinite(), true);
+    std::make_unsigned_t<T> half_range {
+        static_cast<std::make_unsigned_t<T>>(std::make_unsigned_t<T>(1) << (std::numeric_limits<T>::digits - 1))
+    };
+    assert_eq(sss::fraction<T>{1, 2}.pow(std::numeric_limits<T>::digits - 1), sss::fraction<T>{1, half_range});
+    assert_eq(sss::fraction<T>{16, 9}.nth_root(2), sss::fraction<T>{4, 3});
+    assert_eq(sss::fraction<T>{16, 9}.nth_root(-2), sss::fraction<T>{3, 4});
+    assert_eq(sss::fraction<T>{64, 27}.nth_root(3), sss::fraction<T>{4, 3});
+    assert_eq(sss::fraction<T>{2}.nth_root(2).has_value(), false);
+    assert_eq(sss::fraction<T>{16, 9}.nth_root(0).has_value(), false);
+    if(std::is_signed<T>::value)
+    {
+        assert_eq(sss::fraction<std::make_signed_t<T>>{-64, 27}.nth_root(3), sss::fraction<std::make_signed_t<T>>{-4, 3});
+        assert_eq(sss::fraction<std::make_signed_t<T>>{-4, 9}.nth_root(2).has_value(), false);
+    }
     assert_eq(static_cast<T>(sss::fraction<T>{4, 3}), sss::fraction<T>{4, 3}.trunc());
     assert_eq(static_cast<float>(sss::fraction<T>{4, 3}), 4.0f/3.0f);
     assert_eq(static_cast<double>(sss::fraction<T>{4, 3}), 4.0/3.0);
@@ -79,6 +118,16 @@ void test()
     assert_eq(sss::fraction<T>{4, 3}%sss::fraction<T>{5, 7}, sss::fraction<T>{(4*7) % (5*3), 3*7});
     assert_eq(sss::fraction<T>{4, 3}*sss::fraction<T>{5, 7}, sss::fraction<T>{4*5, 3*7});
     assert_eq(sss::fraction<T>{4, 3}/sss::fraction<T>{5, 7}, sss::fraction<T>{4*7, 3*5});
+    if constexpr(std::is_signed<T>::value && sizeof(T) >= 2)
+    {
+        assert_eq(sss::fraction<T>{-1, 6}*sss::fraction<T>{-51, 154}, sss::fraction<T>{17, 308});
+    }
+    // The least common denominator does not fit, so the sum has to be approximated rather than wrap around to 0.
+    constexpr std::make_unsigned_t<T> max_denom {std::numeric_limits<std::make_unsigned_t<T>>::max()};
+    sss::clear_inexact();
+    assert_eq((sss::fraction<T>{1, max_denom} + sss::fraction<T>{1, max_denom - 4}).signum(), 1);
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
     sss::fraction<T> a = {4, 3};
     a += {1, 3};
     assert_eq(a, sss::fraction<T>{5, 3});
@@ -241,6 +290,9 @@ void test()
     assert_eq(sss::fraction<T>{1} / sss::fraction<T>{0}, sss::fraction<T>{1, 0});
     assert_eq(sss::fraction<T>{1, 0} / sss::fraction<T>{0}, sss::fraction<T>{1, 0});
     assert_eq((sss::fraction<T>{0} / sss::fraction<T>{0}).is_nan(), true);
+    assert_eq((sss::fraction<T>{0} / T{0}).is_nan(), true);
+    assert_eq((T{0} / sss::fraction<T>{0}).is_nan(), true);
+    assert_eq((sss::fraction<T>{1, 0} * T{0}).is_nan(), true);
     if(std::is_signed<T>::value)
     {
         assert_eq(
@@ -254,55 +306,1130 @@ void test()
     }
 }
 
+void test_lut()
+{
+    for(unsigned a {0}; a < 256; ++a)
+    {
+        for(unsigned b {0}; b < 256; ++b)
+        {
+            assert_eq(unsigned{sss::lut::gcd(static_cast<std::uint8_t>(a), static_cast<std::uint8_t>(b))}, std::gcd(a, b));
+        }
+    }
+#ifndef SSS_FRACTION_NO_LUT
+    assert_eq(sss::fraction<signed char>{-128, 128}, -1);
+    assert_eq(sss::fraction<signed char>{60, 7} + sss::fraction<signed char>{-128, 13}, sss::fraction<signed char>{-116, 91});
+    assert_eq(sss::fraction<short>{300, 7}*sss::fraction<short>{14, 150}, 4);
+#endif
+}
+
+void test_cia()
+{
+    for(std::uint32_t x {0}; x <= std::numeric_limits<std::uint16_t>::max(); ++x)
+    {
+        for(std::uint64_t k {1}; k <= 17; ++k)
+        {
+            std::uint64_t r {sss::cia::iroot(static_cast<std::uint16_t>(x), k).value()};
+            assert_eq(sss::cia::checked_pow<std::uint64_t>(r, k).value() <= x, true);
+            assert_eq(sss::cia::checked_pow<std::uint64_t>(r + 1, k).value() > x, true);
+        }
+    }
+    assert_eq(sss::cia::iroot(std::numeric_limits<std::uint64_t>::max(), 2), 4294967295u);
+    assert_eq(sss::cia::iroot(-27, 3), -3);
+    assert_eq(sss::cia::iroot(-27, 2).has_value(), false);
+    for(int b {-128}; b < 128; ++b)
+    {
+        long long p {1};
+        for(std::uint64_t e {0}; e < 10; ++e, p *= b)
+        {
+            std::optional<std::int8_t> y {sss::cia::checked_pow(static_cast<std::int8_t>(b), e)};
+            assert_eq(y.has_value(), p >= -128 && p <= 127);
+            assert_eq(y.value_or(0), y.has_value() ? p : 0);
+        }
+    }
+}
+
+void test_stats()
+{
+    using sss::stats::op;
+    sss::stats::counters before {sss::stats::thread_snapshot()};
+    (void)(sss::fraction<int>{1, 3} + 2);
+    (void)(sss::fraction<int>{2147483647, 3}*sss::fraction<int>{2147483646, 5});
+    sss::stats::counters d {sss::stats::thread_snapshot().since(before)};
+    std::uint64_t expected {sss::stats::enabled() ? 1u : 0u};
+    assert_eq(d.calls[static_cast<std::size_t>(op::add)], expected);
+    assert_eq(d.checked_failures[static_cast<std::size_t>(op::add)], 0u);
+    assert_eq(d.calls[static_cast<std::size_t>(op::mul)], expected);
+    assert_eq(d.checked_failures[static_cast<std::size_t>(op::mul)], expected);
+    assert_eq(d.loop_iterations[static_cast<std::size_t>(op::mul)] > 0, sss::stats::enabled());
+    assert_eq(d.reduce_calls > 0, sss::stats::enabled());
+    assert_eq(d.max_relative_error > 0.0, sss::stats::enabled());
+
+    std::uint64_t divisions {sss::stats::snapshot().calls[static_cast<std::size_t>(op::div)]};
+    std::thread{[]()
+    {
+        (void)(sss::fraction<long long>{1, 3}/sss::fraction<long long>{5, 7});
+    }}.join();
+    assert_eq(sss::stats::snapshot().calls[static_cast<std::size_t>(op::div)] - divisions, expected);
+}
+
+void test_status()
+{
+    sss::clear_inexact();
+    (void)(sss::fraction<int>{1, 3} + sss::fraction<int>{1, 6});
+    (void)(sss::fraction<int>{2147483647, 3}*3);
+    assert_eq(sss::test_inexact(), false);
+    (void)(sss::fraction<int>{2147483647, 3}*sss::fraction<int>{2147483646, 5});
+    assert_eq(sss::test_inexact(), true);
+    (void)(sss::fraction<int>{1, 2} + 1);
+    assert_eq(sss::test_inexact(), true);
+    std::thread{[]()
+    {
+        assert_eq(sss::test_inexact(), false);
+    }}.join();
+    sss::clear_inexact();
+    assert_eq(static_cast<sss::fraction<signed char>>(sss::fraction<int>{3, 4}), sss::fraction<signed char>{3, 4});
+    assert_eq(sss::test_inexact(), false);
+    (void)static_cast<sss::fraction<signed char>>(sss::fraction<int>{600, 7});
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
+}
+
+void test_continued_fraction()
+{
+    static_assert(std::ranges::forward_range<sss::partial_quotients_view<int>>);
+    static_assert(std::ranges::view<sss::convergents_view<int>>);
+    static_assert(std::ranges::borrowed_range<sss::convergents_view<int>>);
+    std::vector<long long> terms {};
+    for(long long a : sss::partial_quotients(sss::fraction<long long>{-7, 3}))
+    {
+        terms.push_back(a);
+    }
+    assert_eq(terms == std::vector<long long>{-3, 1, 2}, true);
+    assert_eq(*std::ranges::next(sss::partial_quotients(sss::fraction<unsigned char>{1, 255}).begin()), 255);
+    assert_eq(std::ranges::distance(sss::partial_quotients(sss::fraction<int>{0})), 1);
+    assert_eq(std::ranges::empty(sss::partial_quotients(sss::fraction<int>{1, 0})), true);
+    assert_eq(std::ranges::empty(sss::convergents(sss::fraction<int>{0, 0})), true);
+
+    std::vector<sss::fraction<int>> pi {};
+    for(sss::fraction<int> c : sss::convergents(sss::fraction<int>{103993, 33102}))
+    {
+        pi.push_back(c);
+    }
+    assert_eq(pi.size(), 5u);
+    assert_eq(pi[1], sss::fraction<int>{22, 7});
+    assert_eq(pi[3], sss::fraction<int>{355, 113});
+    assert_eq(pi.back(), sss::fraction<int>{103993, 33102});
+    sss::fraction<int> best {};
+    for(sss::fraction<int> c : sss::convergents(sss::fraction<int>{103993, 33102}, 112u))
+    {
+        best = c;
+    }
+    assert_eq(best, sss::fraction<int>{333, 106});
+    assert_eq(std::ranges::empty(sss::convergents(sss::fraction<int>{1, 2}, 0u)), true);
+    assert_eq(*std::ranges::next(sss::convergents(sss::fraction<int>{-7, 3}).begin()), sss::fraction<int>{-2});
+
+    sss::fraction<unsigned long long> big {std::numeric_limits<unsigned long long>::max(),
+        std::numeric_limits<unsigned long long>::max() - 1};
+    assert_eq(std::ranges::distance(sss::convergents(big)), 2);
+    assert_eq(*std::ranges::next(sss::convergents(big).begin()), big);
+
+    assert_eq(sss::sqrt(sss::fraction<int>{9, 4}), sss::fraction<int>{3, 2});
+    assert_eq(sss::sqrt(sss::fraction<int>{2}, 100u), sss::fraction<int>{140, 99});
+    assert_eq(sss::sqrt(sss::fraction<int>{3, 5}, 100u), sss::fraction<int>{55, 71});
+    assert_eq(sss::sqrt(sss::fraction<int>{16, 9}, 2u), sss::fraction<int>{3, 2});
+    assert_eq(sss::sqrt(sss::fraction<long long>{2}), sss::fraction<long long>{6882627592338442563, 4866752642924153522});
+    assert_eq(sss::sqrt(sss::fraction<int>{-1}).is_nan(), true);
+    assert_eq(sss::sqrt(sss::fraction<int>{1, 0}).is_infinite(), true);
+}
+
+void test_farey()
+{
+    static_assert(std::ranges::forward_range<sss::farey_view<int>>);
+    static_assert(std::ranges::borrowed_range<sss::stern_brocot_view<int>>);
+    std::vector<sss::fraction<int>> f5 {};
+    for(sss::fraction<int> x : sss::farey(5))
+    {
+        f5.push_back(x);
+    }
+    assert_eq(f5 == std::vector<sss::fraction<int>>{{0}, {1, 5}, {1, 4}, {1, 3}, {2, 5}, {1, 2}, {3, 5}, {2, 3},
+        {3, 4}, {4, 5}, {1}}, true);
+    assert_eq(std::ranges::empty(sss::farey(0)), true);
+    assert_eq(std::ranges::empty(sss::farey(-3)), true);
+    assert_eq(std::ranges::distance(sss::farey(1)), 2);
+
+    std::vector<sss::fraction<unsigned char>> expected {};
+    for(unsigned q {1}; q < 256; ++q)
+    {
+        for(unsigned p {0}; p <= q; ++p)
+        {
+            if(std::gcd(p, q) == 1)
+            {
+                expected.push_back({static_cast<unsigned char>(p), static_cast<unsigned char>(q)});
+            }
+        }
+    }
+    std::ranges::sort(expected, [](auto x, auto y)
+    {
+        return unsigned{x.get_numer()}*y.get_denom() < unsigned{y.get_numer()}*x.get_denom();
+    });
+    std::vector<sss::fraction<unsigned char>> generated {};
+    for(sss::fraction<unsigned char> x : sss::farey<unsigned char>(255))
+    {
+        generated.push_back(x);
+    }
+    assert_eq(generated == expected, true);
+    assert_eq(std::ranges::distance(sss::farey<signed char>(127)), 4959);
+
+    using f8 = sss::fraction<signed char>;
+    std::vector<f8> path {};
+    for(f8 x : sss::stern_brocot(f8{3, 10}, f8{7, 20}))
+    {
+        path.push_back(x);
+    }
+    assert_eq(path == std::vector<f8>{{1}, {1, 2}, {1, 3}}, true);
+    assert_eq(std::ranges::distance(sss::stern_brocot(f8{-128}, f8{-128})), 128);
+    assert_eq(sss::simplest_between(f8{-128}, f8{-128}), std::optional<f8>{f8{-128}});
+    assert_eq(sss::simplest_between(f8{5, 2}, f8{1, 0}), std::optional<f8>{f8{3}});
+    assert_eq(sss::simplest_between(f8{-1, 0}, f8{1, 0}), std::optional<f8>{f8{0}});
+    assert_eq(sss::simplest_between(f8{1, 0}, f8{1, 0}).has_value(), false);
+    assert_eq(sss::simplest_between(f8{1, 2}, f8{1, 3}).has_value(), false);
+    assert_eq(sss::simplest_between(f8{0, 0}, f8{1}).has_value(), false);
+    assert_eq(sss::simplest_between(sss::fraction<unsigned long long>{std::numeric_limits<unsigned long long>::max(),
+        std::numeric_limits<unsigned long long>::max() - 1}, sss::fraction<unsigned long long>{2}),
+        std::optional<sss::fraction<unsigned long long>>{2});
+
+    std::vector<f8> grid {};
+    for(int p {-30}; p <= 30; p += 3)
+    {
+        for(int q {1}; q <= 120; q += 7)
+        {
+            grid.push_back({static_cast<signed char>(p), static_cast<unsigned char>(q)});
+        }
+    }
+    auto floor_div = [](int n, int d) { return n/d - (n % d != 0 && n < 0); };
+    for(f8 lower : grid)
+    {
+        for(f8 upper : grid)
+        {
+            int ln {lower.get_numer()};
+            int ld {lower.get_denom()};
+            int un {upper.get_numer()};
+            int ud {upper.get_denom()};
+            std::optional<f8> brute {};
+            for(int q {1}; ln*ud <= un*ld && q < 256 && !brute.has_value(); ++q)
+            {
+                int p {un < 0 ? floor_div(un*q, ud) : std::max(0, -floor_div(-ln*q, ld))};
+                if(p*ld >= ln*q && p*ud <= un*q)
+                {
+                    brute = f8{static_cast<signed char>(p), static_cast<unsigned char>(q)};
+                }
+            }
+            assert_eq(sss::simplest_between(lower, upper), brute);
+            f8 last {0, 0};
+            for(f8 x : sss::stern_brocot(lower, upper))
+            {
+                last = x;
+            }
+            assert_eq(last.get_numer() == brute.value_or(f8{0, 0}).get_numer()
+                && last.get_denom() == brute.value_or(f8{0, 0}).get_denom(), true);
+        }
+    }
+}
+
+template<typename T>
+void test_sort(std::vector<sss::fraction<T>> x)
+{
+    auto exact_less = [](sss::fraction<T> a, sss::fraction<T> b)
+    {
+        auto rank = [](sss::fraction<T> f)
+        {
+            return f.is_nan() ? 3 : f.is_infinite() ? (f.get_numer() < 0 ? 0 : 2) : 1;
+        };
+        if(rank(a) != 1 || rank(b) != 1)
+        {
+            return rank(a) < rank(b);
+        }
+        using W = std::conditional_t<std::is_signed_v<T>, sss::wide::int128_t, sss::wide::uint128_t>;
+        return W{a.get_numer()}*W{b.get_denom()} < W{b.get_numer()}*W{a.get_denom()};
+    };
+    auto same = [](const std::vector<sss::fraction<T>>& a, const std::vector<sss::fraction<T>>& b)
+    {
+        return std::ranges::equal(a, b, [](sss::fraction<T> u, sss::fraction<T> v)
+        {
+            return u.get_numer() == v.get_numer() && u.get_denom() == v.get_denom();
+        });
+    };
+    std::vector<sss::fraction<T>> expected {x};
+    std::ranges::stable_sort(expected, exact_less);
+    std::vector<sss::fraction<T>> sorted {x};
+    sss::sort(sorted);
+    assert_eq(same(sorted, expected), true);
+    sss::parallel_sort(x, 3);
+    assert_eq(same(x, expected), true);
+}
+
+void test_sort()
+{
+    static_assert(sss::fraction_range<std::vector<sss::fraction<int>>&>);
+    static_assert(!sss::fraction_range<std::vector<int>&>);
+
+    std::vector<sss::fraction<signed char>> all8 {};
+    for(int p {-128}; p < 128; ++p)
+    {
+        for(int q {0}; q < 256; ++q)
+        {
+            all8.push_back({static_cast<signed char>(p), static_cast<unsigned char>(q)});
+        }
+    }
+    std::ranges::reverse(all8);
+    test_sort(all8);
+
+    std::mt19937_64 rng {7};
+    std::vector<sss::fraction<long long>> near {};
+    std::vector<sss::fraction<unsigned long long>> unear {};
+    std::vector<sss::fraction<int>> any32 {};
+    for(int i {0}; i < 100000; ++i)
+    {
+        long long d {static_cast<long long>(rng() >> 2) + 2};
+        long long n {static_cast<long long>(rng() % 5) - 2};
+        near.push_back({n*d + static_cast<long long>(rng() % 3), static_cast<unsigned long long>(d)});
+        near.push_back({n*(d - 1) + static_cast<long long>(rng() % 3), static_cast<unsigned long long>(d - 1)});
+        unear.push_back({rng(), rng() | 1});
+        any32.push_back({static_cast<int>(rng()), static_cast<unsigned>(rng() >> 40)});
+    }
+    near.push_back({std::numeric_limits<long long>::min()});
+    near.push_back({std::numeric_limits<long long>::max(), std::numeric_limits<unsigned long long>::max()});
+    test_sort(near);
+    test_sort(unear);
+    test_sort(any32);
+    test_sort(std::vector<sss::fraction<short>>{{1, 0}, {0, 0}, {-1, 3}, {-1, 0}, {2, 6}});
+    test_sort(std::vector<sss::fraction<short>>{});
+
+    // Cross products of values near 1e17 overflow long long, as in operator<, but not the sorter's comparison.
+    sss::fraction_sorter<long long>::less less {};
+    sss::fraction<long long> big_a {100000000000000003, 100000000000000007};
+    sss::fraction<long long> big_b {100000000000000001, 100000000000000005};
+    assert_eq(less(big_a, big_b), false);
+    assert_eq(less(big_b, big_a), true);
+    sss::fraction<long long> big_c {-99999999999999989, 3};
+    sss::fraction<long long> big_d {-33333333333333331};
+    assert_eq(less(big_c, big_d), false);
+    assert_eq(less(big_d, big_c), true);
+
+    std::vector<sss::fraction<long long>> tie {{1, 3}, {-2, 5}, {1, 4}};
+    sss::sort(std::span{tie});
+    assert_eq(tie == std::vector<sss::fraction<long long>>{{-2, 5}, {1, 4}, {1, 3}}, true);
+}
+
+void test_fixed_fraction()
+{
+    using audio = sss::fixed_fraction<int, 48000>;
+    using video = sss::fixed_fraction<int, 90000>;
+    static_assert(sizeof(audio) == sizeof(int));
+    static_assert(std::is_same_v<decltype(audio{} + video{}), sss::fixed_fraction<int, 720000>>);
+    static_assert(sss::common_timebase_v<int, 48000, 90000> == 720000);
+
+    audio a {audio::from_ticks(480)};
+    a += audio::from_ticks(20);
+    assert_eq(a.get_ticks(), 500);
+    assert_eq((a - audio::from_ticks(600)).get_ticks(), -100);
+    assert_eq((3*a).get_ticks(), 1500);
+    assert_eq((-a).get_ticks(), -500);
+    assert_eq(static_cast<sss::fraction<int>>(a), sss::fraction<int>{1, 96});
+    assert_eq(static_cast<double>(audio::from_ticks(24000)), 0.5);
+    assert_eq(audio::from_fraction(sss::fraction<int>{1, 96}).value(), a);
+    assert_eq(audio::from_fraction(sss::fraction<int>{1, 7}).has_value(), false);
+    assert_eq(audio::from_fraction(sss::fraction<int>{100000}).has_value(), false);
+    assert_eq(audio::from_fraction(sss::fraction<int>{1, 0}).has_value(), false);
+    assert_eq(static_cast<sss::fixed_fraction<int, 96000>>(a).get_ticks(), 1000);
+
+    assert_eq((audio::from_ticks(1) + video::from_ticks(1)).get_ticks(), 23);
+    assert_eq((audio::from_ticks(3) - video::from_ticks(5)).get_ticks(), 5);
+    assert_eq(audio::from_ticks(48000) == video::from_ticks(90000), true);
+    assert_eq(audio::from_ticks(8) < video::from_ticks(15), false);
+    assert_eq(audio::from_ticks(8) > video::from_ticks(14), true);
+
+    using a8 = sss::fixed_fraction<signed char, 250>;
+    using b8 = sss::fixed_fraction<signed char, 3>;
+    assert_eq(a8::from_ticks(127) > b8::from_ticks(1), true);
+    assert_eq(a8::from_ticks(-128) < b8::from_ticks(-1), true);
+    for(int t {0}; t < 256; ++t)
+    {
+        sss::fixed_fraction<unsigned char, 255> x {sss::fixed_fraction<unsigned char, 255>::from_ticks(
+            static_cast<unsigned char>(t))};
+        assert_eq(sss::fixed_fraction<unsigned char, 255>::from_fraction(static_cast<sss::fraction<unsigned char>>(x)),
+            std::optional{x});
+    }
+}
+
+constexpr sss::rounding rounding_modes[] {
+    sss::rounding::floor,
+    sss::rounding::ceil,
+    sss::rounding::nearest_even,
+    sss::rounding::nearest_away,
+    sss::rounding::toward_zero
+};
+
+// a*from/to rounded with 128-bit arithmetic, which is exact for operands of up to 32 bits.
+sss::wide::int128_t rescale_reference(sss::wide::int128_t numer, sss::wide::int128_t denom, sss::rounding mode)
+{
+    if(denom < 0)
+    {
+        numer = -numer;
+        denom = -denom;
+    }
+    sss::wide::int128_t q {numer/denom - (numer % denom < 0)};
+    sss::wide::int128_t r {numer - q*denom};
+    switch(mode)
+    {
+        case sss::rounding::floor:
+            return q;
+        case sss::rounding::ceil:
+            return q + (r != 0);
+        case sss::rounding::nearest_even:
+            return q + (2*r > denom || (2*r == denom && q % 2 != 0));
+        case sss::rounding::nearest_away:
+            return q + (2*r > denom || (2*r == denom && q >= 0));
+        case sss::rounding::toward_zero:
+            return q + (r != 0 && q < 0);
+    }
+    return q;
+}
+
+template<typename T>
+void test_rescale(const std::vector<T>& values, const std::vector<sss::fraction<T>>& timebases)
+{
+    for(T a : values)
+    {
+        for(const sss::fraction<T>& from : timebases)
+        {
+            for(const sss::fraction<T>& to : timebases)
+            {
+                for(sss::rounding mode : rounding_modes)
+                {
+                    bool valid {from.is_finite() && to.is_finite() && !to.is_zero()};
+                    sss::wide::int128_t expected {0};
+                    if(valid)
+                    {
+                        expected = rescale_reference(
+                            sss::wide::int128_t{a}*from.get_numer()*to.get_denom(),
+                            sss::wide::int128_t{from.get_denom()}*to.get_numer(),
+                            mode
+                        );
+                        valid = expected >= std::numeric_limits<T>::min() && expected <= std::numeric_limits<T>::max();
+                    }
+                    std::optional<T> x {sss::rescale(a, from, to, mode)};
+                    assert_eq(x.has_value(), valid);
+                    if(x)
+                    {
+                        assert_eq(sss::wide::int128_t{*x} == expected, true);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void test_rescale()
+{
+    std::vector<signed char> all8 {};
+    for(int a {-128}; a < 128; ++a)
+    {
+        all8.push_back(static_cast<signed char>(a));
+    }
+    std::vector<unsigned char> allu8 {};
+    for(int a {0}; a < 256; ++a)
+    {
+        allu8.push_back(static_cast<unsigned char>(a));
+    }
+    using f8 = sss::fraction<signed char>;
+    using u8 = sss::fraction<unsigned char>;
+    test_rescale(all8, {f8{1, 3}, f8{-2, 5}, f8{7}, f8{1, 255}, f8{-128}, f8{127, 254}, f8{0}, f8{1, 0}, f8{0, 0}});
+    test_rescale(allu8, {u8{1, 3}, u8{2, 5}, u8{255}, u8{1, 255}, u8{254, 255}, u8{0}, u8{1, 0}});
+
+    // Timebases near the limits of int have ratios that need all 64 bits, which takes the bitwise path.
+    std::mt19937 rng {7};
+    std::uniform_int_distribution<int> any {std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    std::uniform_int_distribution<int> near {std::numeric_limits<int>::max() - 100, std::numeric_limits<int>::max()};
+    std::vector<int> values {0, 1, -1, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    std::vector<sss::fraction<int>> timebases {{1, 48000}, {1001, 30000}, {1, 0}};
+    for(int i {0}; i < 20; ++i)
+    {
+        values.push_back(any(rng));
+        values.push_back(near(rng));
+        timebases.emplace_back(near(rng), static_cast<unsigned>(near(rng)));
+        timebases.emplace_back(-near(rng), static_cast<unsigned>(any(rng)));
+    }
+    test_rescale(values, timebases);
+
+    using f64 = sss::fraction<long long>;
+    assert_eq(sss::rescale(90000LL, f64{1, 90000}, f64{1, 48000}, sss::rounding::floor), std::optional{48000LL});
+    assert_eq(sss::rescale(1001LL, f64{1, 30000}, f64{1, 90000}, sss::rounding::floor), std::optional{3003LL});
+    assert_eq(sss::rescale(1LL, f64{1, 2}, f64{1}, sss::rounding::nearest_even), std::optional{0LL});
+    assert_eq(sss::rescale(3LL, f64{1, 2}, f64{1}, sss::rounding::nearest_even), std::optional{2LL});
+    assert_eq(sss::rescale(-1LL, f64{1, 2}, f64{1}, sss::rounding::nearest_away), std::optional{-1LL});
+    assert_eq(sss::rescale(-1LL, f64{1, 2}, f64{1}, sss::rounding::ceil), std::optional{0LL});
+    assert_eq(sss::rescale(-1LL, f64{1, 2}, f64{1}, sss::rounding::floor), std::optional{-1LL});
+    assert_eq(sss::rescale(1LL, f64{1, 0}, f64{1}, sss::rounding::floor).has_value(), false);
+    assert_eq(sss::rescale(1LL, f64{1}, f64{0}, sss::rounding::floor).has_value(), false);
+
+    constexpr long long big {std::numeric_limits<long long>::max()};
+    assert_eq(sss::rescale(big - 10, f64{big, big - 2}, f64{big - 4, static_cast<unsigned long long>(big)},
+        sss::rounding::floor), std::optional{big - 5});
+    assert_eq(sss::rescale(big - 10, f64{big, big - 2}, f64{big - 4, static_cast<unsigned long long>(big)},
+        sss::rounding::nearest_even), std::optional{big - 4});
+    assert_eq(sss::rescale(big, f64{big, 1}, f64{1, static_cast<unsigned long long>(big)},
+        sss::rounding::floor).has_value(), false);
+}
+
+template<typename T>
+void test_quantize(void)
+{
+    std::vector<sss::fraction<T>> x {};
+    for(int numer {std::numeric_limits<T>::min()}; numer <= std::numeric_limits<T>::max(); ++numer)
+    {
+        for(int denom {0}; denom <= std::numeric_limits<std::make_unsigned_t<T>>::max(); denom += 3)
+        {
+            x.emplace_back(static_cast<T>(numer), static_cast<std::make_unsigned_t<T>>(denom));
+        }
+    }
+    std::vector<T> ticks(x.size());
+    for(int n : {0, 1, 2, 3, 24, 100, 255})
+    {
+        std::make_unsigned_t<T> grid {static_cast<std::make_unsigned_t<T>>(n)};
+        for(sss::rounding mode : rounding_modes)
+        {
+            bool all {sss::quantize_ticks<T>(x, grid, mode, ticks)};
+            bool expected_all {true};
+            for(std::size_t i {0}; i < x.size(); ++i)
+            {
+                bool valid {x[i].is_finite() && n != 0};
+                sss::wide::int128_t expected {0};
+                if(valid)
+                {
+                    expected = rescale_reference(sss::wide::int128_t{x[i].get_numer()}*n, x[i].get_denom(), mode);
+                    valid = expected >= std::numeric_limits<T>::min() && expected <= std::numeric_limits<T>::max();
+                }
+                std::optional<T> k {sss::quantize_ticks(x[i], grid, mode)};
+                assert_eq(k.has_value(), valid);
+                assert_eq(sss::wide::int128_t{ticks[i]}, valid ? expected : 0);
+                if(k)
+                {
+                    assert_eq(sss::wide::int128_t{*k}, expected);
+                    assert_eq(sss::quantize(x[i], grid, mode), std::optional{sss::fraction<T>{*k, grid}});
+                }
+                expected_all &= valid;
+            }
+            assert_eq(all, expected_all);
+        }
+    }
+}
+
+void test_quantize(void)
+{
+    test_quantize<signed char>();
+    test_quantize<unsigned char>();
+
+    using f64 = sss::fraction<long long>;
+    assert_eq(sss::quantize(f64{1, 48}, 24u, sss::rounding::nearest_even), std::optional{f64{0}});
+    assert_eq(sss::quantize(f64{3, 48}, 24u, sss::rounding::nearest_even), std::optional{f64{1, 12}});
+    assert_eq(sss::quantize(f64{-3, 48}, 24u, sss::rounding::nearest_away), std::optional{f64{-1, 12}});
+    assert_eq(sss::quantize(f64{-1, 7}, 24u, sss::rounding::toward_zero), std::optional{f64{-1, 8}});
+    assert_eq(sss::quantize(f64{-1, 7}, 24u, sss::rounding::floor), std::optional{f64{-1, 6}});
+    assert_eq(sss::quantize_ticks(f64{std::numeric_limits<long long>::max(), 3}, 4u, sss::rounding::floor).has_value(),
+        false);
+}
+
+// |x - numer/denom| for an exact x = x_numer/x_denom, as a fraction of 128-bit integers that is only ever compared.
+std::pair<sss::wide::int128_t, sss::wide::int128_t> distance(sss::wide::int128_t x_numer, sss::wide::int128_t x_denom,
+    sss::wide::int128_t numer, sss::wide::int128_t denom)
+{
+    sss::wide::int128_t d {x_numer*denom - numer*x_denom};
+    return {d < 0 ? -d : d, x_denom*denom};
+}
+
+// The fused result must be the exact value when it fits and otherwise as near to it as any signed char fraction.
+void check_fused(sss::wide::int128_t numer, sss::wide::int128_t denom, sss::fraction<signed char> x)
+{
+    if(denom < 0)
+    {
+        numer = -numer;
+        denom = -denom;
+    }
+    sss::wide::int128_t g {std::gcd(static_cast<long long>(numer < 0 ? -numer : numer), static_cast<long long>(denom))};
+    numer /= g;
+    denom /= g;
+    if(numer >= -128 && numer <= 127 && denom <= 255)
+    {
+        assert_eq(sss::wide::int128_t{x.get_numer()} == numer && sss::wide::int128_t{x.get_denom()} == denom, true);
+        return;
+    }
+    std::pair<sss::wide::int128_t, sss::wide::int128_t> d {distance(numer, denom, x.get_numer(), x.get_denom())};
+    for(int q {1}; q < 256; ++q)
+    {
+        for(int p {-128}; p < 128; ++p)
+        {
+            std::pair<sss::wide::int128_t, sss::wide::int128_t> e {distance(numer, denom, p, q)};
+            assert_eq(e.first*d.second >= d.first*e.second, true);
+        }
+    }
+}
+
+void test_fused(void)
+{
+    using f8 = sss::fraction<signed char>;
+    std::mt19937 rng {11};
+    std::uniform_int_distribution<int> numer {-128, 127};
+    std::uniform_int_distribution<int> denom {1, 255};
+    auto random = [&]()
+    {
+        return f8{static_cast<signed char>(numer(rng)), static_cast<unsigned char>(denom(rng))};
+    };
+    for(int i {0}; i < 300; ++i)
+    {
+        f8 a {random()};
+        f8 b {random()};
+        f8 c {random()};
+        sss::wide::int128_t n {sss::wide::int128_t{a.get_numer()}*b.get_numer()*c.get_denom()
+            + sss::wide::int128_t{c.get_numer()}*a.get_denom()*b.get_denom()};
+        check_fused(n, sss::wide::int128_t{a.get_denom()}*b.get_denom()*c.get_denom(), sss::fma(a, b, c));
+    }
+    for(int i {0}; i < 100; ++i)
+    {
+        std::vector<f8> a(3);
+        std::vector<f8> b(3);
+        sss::wide::int128_t n {0};
+        sss::wide::int128_t d {1};
+        for(std::size_t j {0}; j < a.size(); ++j)
+        {
+            a[j] = random();
+            b[j] = i % 2 == 0 ? f8{static_cast<signed char>(numer(rng))} : random();
+            sss::wide::int128_t pd {sss::wide::int128_t{a[j].get_denom()}*b[j].get_denom()};
+            n = n*pd + sss::wide::int128_t{a[j].get_numer()}*b[j].get_numer()*d;
+            d *= pd;
+            sss::wide::int128_t g {std::gcd(static_cast<long long>(n < 0 ? -n : n), static_cast<long long>(d))};
+            n /= g;
+            d /= g;
+        }
+        check_fused(n, d, sss::dot<signed char>(a, b));
+    }
+
+    sss::clear_inexact();
+    assert_eq(sss::fma(f8{1, 3}, f8{3, 4}, f8{1, 6}), f8{5, 12});
+    assert_eq(sss::test_inexact(), false);
+    assert_eq(sss::fma(f8{100}, f8{100}, f8{-100}), f8{127});
+    assert_eq(sss::test_inexact(), true);
+    assert_eq(sss::fma(f8{1, 0}, f8{2}, f8{1}), f8{1, 0});
+    assert_eq(sss::fma(f8{0, 0}, f8{2}, f8{1}).is_nan(), true);
+
+    std::vector<sss::fraction<short>> coefficients {};
+    std::vector<sss::fraction<short>> window {};
+    sss::fraction<short> expected {0};
+    for(short i {0}; i < 32; ++i)
+    {
+        coefficients.emplace_back(static_cast<short>(i*37 % 512 - 256), 1024u);
+        window.emplace_back(static_cast<short>(i % 7 - 3));
+        expected = expected + coefficients.back()*window.back();
+    }
+    assert_eq(sss::dot<short>(coefficients, window), expected);
+
+    using f64 = sss::fraction<long long>;
+    std::vector<f64> taps {{1, 4}, {1, 2}, {1, 4}};
+    std::vector<f64> samples {{3}, {-5}, {8}};
+    assert_eq(sss::dot<long long>(taps, samples), f64{1, 4});
+    assert_eq(sss::dot<long long>(taps, std::vector<f64>{}), f64{0});
+    constexpr long long big {std::numeric_limits<long long>::max()};
+    assert_eq(sss::fma(f64{big, 2}, f64{2, 3}, f64{-big, 3}), f64{0});
+    std::vector<f64> with_nan {{1}, {0, 0}};
+    assert_eq(sss::dot<long long>(with_nan, with_nan).is_nan(), true);
+
+    // Denominators near 2^62 overflow the 128-bit accumulator, and the results must still be the nearest
+    // fraction<long long> to the exact value, as found with Python's Fraction.limit_denominator.
+    sss::clear_inexact();
+    assert_eq(sss::fma(
+        f64{-2459773508118483297, 4056295435839075755u},
+        f64{364951308724209407, 1671013181121197429u},
+        f64{-230307437161561645, 308591945293667847u}
+    ), f64{-7447137500103081093, 8474621790482423780u});
+    assert_eq(sss::test_inexact(), true);
+    assert_eq(sss::fma(
+        f64{998746994870471625, 1934189316618728173u},
+        f64{603754826407218031, 3039324358305783960u},
+        f64{368963353562415826, 3760500079450652283u}
+    ), f64{2686421089659939101, 13385913446223672814u});
+    assert_eq(sss::fma(
+        f64{26159512230685139, 139100154332273467u},
+        f64{-2844249297350232895, 4501496581504046576u},
+        f64{-548046606061231552, 1452779354066244137u}
+    ), f64{-3745833505917584297, 7551072256688700952u});
+    std::vector<f64> wide_taps {
+        {-1270090189487894654, 1336642016813746153u},
+        {1358161014865929788, 1465946809465487629u},
+        {-1833848632460172718, 4535366052602119785u},
+        {64493405033815156, 293585643719121291u}
+    };
+    std::vector<f64> wide_samples {
+        {292730835177021967, 2085706833854095064u},
+        {2046538963401606523, 2823923079977290406u},
+        {-483396048714539219, 4491530046095404807u},
+        {-1979659475419956710, 2330731515059039461u}
+    };
+    assert_eq(sss::dot<long long>(wide_taps, wide_samples), f64{3980972844228318423, 10078473144706273939u});
+}
+
+void test_lazy(void)
+{
+    using f8 = sss::fraction<signed char>;
+    std::mt19937 rng {13};
+    std::uniform_int_distribution<int> numer {-128, 127};
+    std::uniform_int_distribution<int> denom {1, 255};
+    auto random = [&]()
+    {
+        return f8{static_cast<signed char>(numer(rng)), static_cast<unsigned char>(denom(rng))};
+    };
+    for(int i {0}; i < 300; ++i)
+    {
+        f8 a {random()};
+        f8 b {random()};
+        f8 c {random()};
+        f8 d {random()};
+        f8 e {random()};
+        if(e.is_zero())
+        {
+            continue;
+        }
+        using sss::wide::int128_t;
+        int128_t n {(int128_t{a.get_numer()}*b.get_denom() + int128_t{b.get_numer()}*a.get_denom())*c.get_numer()
+            *d.get_denom()*e.get_numer()
+            - int128_t{d.get_numer()}*e.get_denom()*a.get_denom()*b.get_denom()*c.get_denom()};
+        int128_t m {int128_t{a.get_denom()}*b.get_denom()*c.get_denom()*d.get_denom()*e.get_numer()};
+        check_fused(n, m, (sss::lazy(a) + b)*c - sss::lazy(d)/e);
+    }
+
+    sss::clear_inexact();
+    assert_eq(f8{sss::lazy(f8{100}) + f8{100} - f8{120}}, f8{80});
+    assert_eq(f8{sss::lazy(f8{1, 200})*f8{1, 3}*f8{120}}, f8{1, 5});
+    assert_eq(f8{(sss::lazy(f8{1, 3}) + 1)*3 - sss::lazy(f8{1, 2})/f8{1, 4}}, f8{2});
+    assert_eq(f8{2 - sss::lazy(f8{1, 3})*f8{3}}, f8{1});
+    assert_eq(sss::test_inexact(), false);
+    assert_eq(f8{sss::lazy(f8{100})*f8{100}/f8{3}}, f8{127});
+    assert_eq(sss::test_inexact(), true);
+    assert_eq(f8{sss::lazy(f8{1})/f8{0} + f8{1}}, f8{1, 0});
+    assert_eq(f8{sss::lazy(f8{0, 0}) + f8{1}}.is_nan(), true);
+    assert_eq(f8{sss::lazy(f8{1, 0})*f8{2}}, f8{1, 0});
+
+    using f64 = sss::fraction<long long>;
+    constexpr long long big {std::numeric_limits<long long>::max()};
+    assert_eq(f64{(sss::lazy(f64{big}) + f64{big})/f64{4} - f64{big, 2}}, f64{0});
+    assert_eq(f64{sss::lazy(f64{big, 3})*f64{3, big}}, f64{1});
+
+    // Trees that outgrow the accumulator are finished in 256 bits, as Python's Fraction.limit_denominator finds.
+    const f64 a {-2459773508118483297, 4056295435839075755u};
+    const f64 b {364951308724209407, 1671013181121197429u};
+    const f64 c {-230307437161561645, 308591945293667847u};
+    const f64 d {998746994870471625, 1934189316618728173u};
+    sss::clear_inexact();
+    assert_eq(f64{sss::lazy(a)*b + c}, f64{-7447137500103081093, 8474621790482423780u});
+    assert_eq(sss::test_inexact(), true);
+    assert_eq(f64{(sss::lazy(a)*b + c)*d}, f64{-1956686868821227831, 4312169048203441788u});
+    assert_eq(f64{(sss::lazy(a)*b + c)/f64{0}}, f64{-1, 0});
+    sss::clear_inexact();
+
+    // A negative result has no unsigned value to wrap to, so it becomes the nearest one, 0.
+    using u8 = sss::fraction<unsigned char>;
+    using u32 = sss::fraction<unsigned>;
+    sss::clear_inexact();
+    assert_eq(u8{sss::lazy(u8{1, 2}) - u8{1, 3}}, u8{1, 6});
+    assert_eq(u32{u32{3} - sss::lazy(u32{2})*u32{1}}, u32{1});
+    assert_eq(u8{sss::lazy(u8{1, 3}) - u8{1, 2} + u8{1, 2}}, u8{1, 3});
+    assert_eq(sss::test_inexact(), false);
+    assert_eq(u32{u32{1} - sss::lazy(u32{2})}, u32{0});
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
+    assert_eq(u8{sss::lazy(u8{1, 3}) - u8{1, 2}}, u8{0});
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
+}
+
 template<typename T>
-void test_all()
+void test_atomic_fraction(void)
+{
+    using f = sss::fraction<T>;
+    sss::atomic_fraction<T> x {};
+    assert_eq(x.load(), f{0});
+    x.store(f{1, 3});
+    assert_eq(x.fetch_add(f{1, 6}), f{1, 3});
+    assert_eq(x.fetch_mul(f{4}), f{1, 2});
+    assert_eq(x.fetch_sub(f{1, 2}), f{2});
+    assert_eq(x.fetch_div(f{3}), f{3, 2});
+    assert_eq(x.exchange(f{5, 7}), f{1, 2});
+    f expected {1, 2};
+    assert_eq(x.compare_exchange_strong(expected, f{1}), false);
+    assert_eq(expected, f{5, 7});
+    assert_eq(x.compare_exchange_strong(expected, f{1}), true);
+    assert_eq(static_cast<f>(x), f{1});
+    x = f{0, 0};
+    expected = f{0, 0};
+    assert_eq(x.compare_exchange_strong(expected, f{0}), true);
+    assert_eq(x.is_lock_free(), sss::atomic_fraction<T>::is_always_lock_free);
+
+    sss::atomic_fraction<T> played {};
+    std::vector<std::thread> threads {};
+    for(int t {0}; t < 4; ++t)
+    {
+        threads.emplace_back([&played]()
+        {
+            for(int i {0}; i < 3000; ++i)
+            {
+                played.fetch_add(f{1, 48000});
+            }
+        });
+    }
+    for(std::thread& t : threads)
+    {
+        t.join();
+    }
+    assert_eq(played.load(), f{1, 4});
+}
+
+void test_sharded_fraction_sum(void)
+{
+    using f = sss::fraction<int>;
+    sss::sharded_fraction_sum<int> sum {4};
+    assert_eq(sum.shard_count(), 4u);
+    assert_eq(sum.load(), f{0});
+    std::vector<std::thread> threads {};
+    for(int t {0}; t < 6; ++t)
+    {
+        threads.emplace_back([&sum, t]()
+        {
+            for(int i {0}; i < 1000; ++i)
+            {
+                sum += f{1, static_cast<unsigned int>(t + 2)};
+            }
+        });
+    }
+    for(std::thread& t : threads)
+    {
+        t.join();
+    }
+    assert_eq(static_cast<f>(sum), f{11150, 7});
+    sum.reset();
+    sum.add(f{-3, 4});
+    assert_eq(sum.load(), f{-3, 4});
+
+    sss::sharded_fraction_sum<long long> single {0};
+    assert_eq(single.shard_count(), 1u);
+    single += sss::fraction<long long>{1, 3};
+    single += sss::fraction<long long>{1, 6};
+    assert_eq(single.load(), sss::fraction<long long>{1, 2});
+
+    // One thread adds 1 and the other then takes it away, on their own shards, so the sum is only ever 0 or 1; a read
+    // that took the shards at different instants could see -1 or 2.
+    sss::sharded_fraction_sum<long long> ping {2};
+    std::atomic<int> turn {0};
+    constexpr int rounds {20000};
+    std::thread up {[&]()
+    {
+        for(int i {0}; i < rounds; ++i)
+        {
+            while(turn.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+            ping += sss::fraction<long long>{1};
+            turn.store(1);
+        }
+    }};
+    std::thread down {[&]()
+    {
+        for(int i {0}; i < rounds; ++i)
+        {
+            while(turn.load() != 1)
+            {
+                std::this_thread::yield();
+            }
+            ping += sss::fraction<long long>{-1};
+            turn.store(0);
+        }
+    }};
+    bool consistent {true};
+    for(int i {0}; i < rounds; ++i)
+    {
+        sss::fraction<long long> x {ping.load()};
+        consistent = consistent && (x == sss::fraction<long long>{0} || x == sss::fraction<long long>{1});
+    }
+    up.join();
+    down.join();
+    assert_eq(consistent, true);
+    assert_eq(ping.load(), sss::fraction<long long>{0});
+}
+
+// An unpacked result of P must be the exact value when it fits the split and otherwise as near to it as every
+// fraction that does, found for each denominator from the two numerators either side of the value.
+template<typename P>
+void check_packed(sss::wide::int128_t numer, sss::wide::int128_t denom, sss::fraction<std::int32_t> x)
+{
+    sss::wide::int128_t g {std::gcd(static_cast<long long>(numer < 0 ? -numer : numer), static_cast<long long>(denom))};
+    numer /= g;
+    denom /= g;
+    if(numer >= P::min_numer && numer <= P::max_numer && denom <= P::max_denom)
+    {
+        assert_eq(sss::wide::int128_t{x.get_numer()} == numer && sss::wide::int128_t{x.get_denom()} == denom, true);
+        return;
+    }
+    assert_eq(x.get_numer() >= P::min_numer && x.get_numer() <= P::max_numer && x.get_denom() <= P::max_denom, true);
+    std::pair<sss::wide::int128_t, sss::wide::int128_t> d {distance(numer, denom, x.get_numer(), x.get_denom())};
+    for(sss::wide::int128_t q {1}; q <= P::max_denom; ++q)
+    {
+        sss::wide::int128_t floor {numer*q/denom - (numer*q % denom < 0)};
+        for(sss::wide::int128_t p : {floor, floor + 1})
+        {
+            p = std::clamp<sss::wide::int128_t>(p, P::min_numer, P::max_numer);
+            std::pair<sss::wide::int128_t, sss::wide::int128_t> e {distance(numer, denom, p, q)};
+            assert_eq(e.first*d.second >= d.first*e.second, true);
+        }
+    }
+}
+
+void test_packed_fraction(void)
+{
+    using p32 = sss::packed_fraction<32, 20>;
+    using f32 = sss::fraction<std::int32_t>;
+    assert_eq(p32{}.unpack(), f32{0});
+    assert_eq(p32{f32{-3, 4}}.get_numer(), -3);
+    assert_eq(p32{f32{-3, 4}}.get_denom(), 4u);
+    assert_eq(p32::from_bits(p32{f32{-3, 4}}.get_bits()).unpack(), f32{-3, 4});
+    assert_eq(p32::pack(f32{524287, 4095}).has_value(), true);
+    assert_eq(p32::pack(f32{-524288}).has_value(), true);
+    assert_eq(p32::pack(f32{524288}).has_value(), false);
+    assert_eq(p32::pack(f32{1, 4096}).has_value(), false);
+
+    sss::clear_inexact();
+    assert_eq(p32{f32{1, 3}} + p32{f32{1, 6}}, p32{f32{1, 2}});
+    assert_eq(p32{f32{524287, 4093}}*p32{f32{4093, 7}}, p32{f32{524287, 7}});
+    assert_eq(p32{f32{-7, 5}} - p32{f32{3, 10}}, p32{f32{-17, 10}});
+    assert_eq(p32{f32{1, 3}} < p32{f32{1, 2}}, true);
+    assert_eq(sss::test_inexact(), false);
+    assert_eq(p32{f32{1, 4096}}.unpack(), f32{1, 4095});
+    assert_eq(sss::test_inexact(), true);
+    assert_eq(p32{f32{1000000}}.unpack(), f32{524287});
+    assert_eq(p32{f32{-1000000}}.unpack(), f32{-524288});
+    assert_eq((p32{f32{1, 4000}}*p32{f32{1, 3}}).unpack(), f32{0});
+    assert_eq((-p32{f32{-524288}}).unpack(), f32{524287});
+    assert_eq((p32{f32{1}}/p32{f32{0}}).is_infinite(), true);
+    assert_eq((p32{f32{-1}}/p32{f32{0}}).unpack(), f32{-1, 0});
+    assert_eq(p32{f32{0, 0}}.is_nan(), true);
+    assert_eq(p32{f32{0, 0}} == p32{f32{0, 0}}, false);
+    sss::clear_inexact();
+
+    // Products and sums of packed values always fit in the accumulator, so every result must be the exact one
+    // rounded once to the split.
+    std::mt19937 rng {17};
+    std::uniform_int_distribution<std::int32_t> numer {p32::min_numer, p32::max_numer};
+    std::uniform_int_distribution<std::uint32_t> denom {1, p32::max_denom};
+    for(int i {0}; i < 1000; ++i)
+    {
+        f32 a {numer(rng), denom(rng)};
+        f32 b {numer(rng), denom(rng)};
+        std::int64_t an {a.get_numer()};
+        std::int64_t bn {b.get_numer()};
+        std::int64_t ad {a.get_denom()};
+        std::int64_t bd {b.get_denom()};
+        check_packed<p32>(an*bd + bn*ad, ad*bd, (p32{a} + p32{b}).unpack());
+        check_packed<p32>(an*bn, ad*bd, (p32{a}*p32{b}).unpack());
+    }
+    sss::clear_inexact();
+
+    using p64 = sss::packed_fraction<64, 40>;
+    using f64 = sss::fraction<std::int64_t>;
+    assert_eq(p64{f64{549755813887, 16777215}}.unpack(), f64{549755813887, 16777215});
+    assert_eq(p64{f64{-549755813888, 3}}.get_numer(), -549755813888);
+    assert_eq((p64{f64{1, 16777215}} + p64{f64{2, 16777215}}).unpack(), f64{1, 5592405});
+    assert_eq(p64{f64{1, 16777215}}*p64{f64{16777215}}, p64{f64{1}});
+    sss::clear_inexact();
+}
+
+void test_adaptive_fraction(void)
+{
+    using af = sss::adaptive_fraction;
+    using f32 = sss::fraction<std::int32_t>;
+    using f64 = sss::fraction<std::int64_t>;
+    constexpr std::int32_t max32 {std::numeric_limits<std::int32_t>::max()};
+    constexpr std::int64_t max64 {std::numeric_limits<std::int64_t>::max()};
+    sss::clear_inexact();
+    assert_eq(af{}, af{f32{0}});
+    assert_eq(af{5}, af{f32{10, 2}});
+    assert_eq(af{f32{1, 3}}.get_width(), 32u);
+    assert_eq(af{f64{1, 3}}.get_width(), 32u);
+    assert_eq(af{f64{max64}}.get_width(), 64u);
+    assert_eq(af{sss::fraction<std::uint64_t>{std::numeric_limits<std::uint64_t>::max()}}.get_width(), 128u);
+
+    af a {af{f32{max32}} + af{1}};
+    assert_eq(a.get_width(), 64u);
+    assert_eq(a, af{f64{std::int64_t{max32} + 1}});
+    assert_eq((a - af{1}).get_width(), 32u);
+    assert_eq((-af{f32{std::numeric_limits<std::int32_t>::min()}}).get_width(), 64u);
+    af b {af{f32{1, 4294967295u}} + af{f32{1, 4294967291u}}};
+    assert_eq(b.get_width(), 64u);
+    assert_eq(b, af{f64{8589934586, 18446744047939747845u}});
+
+    af c {af{f64{max64}}*af{f64{max64}}};
+    assert_eq(c.get_width(), 128u);
+    assert_eq(c.get_numer(), sss::wide::int128_t{max64}*max64);
+    assert_eq(c.get_denom(), 1u);
+    assert_eq(c/af{f64{max64}}, af{f64{max64}});
+    assert_eq((c/af{f64{max64}}).get_width(), 64u);
+    assert_eq(c > af{f64{max64}}, true);
+    assert_eq(c < c + af{f32{1, 2}}, true);
+    assert_eq((c + af{f32{1, 2}}).get_denom(), 2u);
+    assert_eq(-c < af{f64{-max64}}, true);
+    assert_eq(sss::test_inexact(), false);
+
+    // Products of 128-bit values whose gcds cancel across them, and a sum whose numerator over the least common
+    // denominator needs 173 bits but whose reduced value fits in 128, must all stay exact.
+    af x {(c + af{1})/af{3}};
+    assert_eq(x.get_width(), 128u);
+    assert_eq(x*(af{1}/x), af{1});
+    assert_eq((x*(af{1}/x)).get_width(), 32u);
+    assert_eq(x/x, af{1});
+    assert_eq((x*af{3})/(c + af{1}), af{1});
+    constexpr std::int64_t prime {4611686018427387847};
+    af u {af{f64{3483875223180573765, prime}}*af{f64{3959296221816144025, 1125899906842597}}};
+    af v {af{f64{3622075755646026072, prime}}*af{f64{421679645840244, 562949953421231}}};
+    af s {u + v};
+    assert_eq(s.get_denom(), sss::wide::uint128_t{1125899906842597}*562949953421231u);
+    assert_eq(s - v, u);
+    assert_eq(s - u, v);
+    assert_eq(s - u - v, af{});
+    assert_eq(-v + s - u + v, v);
+    af d {af{f64{-6654009912319350480, 1515582361}} - af{f64{16252217337915247, 54007974885082587}}};
+    assert_eq(d + af{f64{16252217337915247, 54007974885082587}}, af{f64{-6654009912319350480, 1515582361}});
+    assert_eq(sss::test_inexact(), false);
+
+    // The harmonic numbers outgrow 32 and then 64 bits, and taking the terms away again must come back to exactly 0.
+    af h {};
+    for(int k {1}; k <= 80; ++k)
+    {
+        h += af{f32{1, static_cast<std::uint32_t>(k)}};
+        if(k == 20)
+        {
+            assert_eq(h, af{f32{55835135, 15519504}});
+            assert_eq(h.get_width(), 32u);
+        }
+    }
+    assert_eq(h.get_width(), 128u);
+    assert_eq(static_cast<double>(h) > 4.965 && static_cast<double>(h) < 4.966, true);
+    for(int k {80}; k >= 1; --k)
+    {
+        h -= af{f32{1, static_cast<std::uint32_t>(k)}};
+    }
+    assert_eq(h, af{});
+    assert_eq(h.get_width(), 32u);
+    assert_eq(sss::test_inexact(), false);
+
+    // Sums and products of 32-bit values always fit in 128 bits, so every result must be exact and at its narrowest.
+    using arithmetic = sss::fused_arithmetic<std::int64_t>;
+    std::mt19937 rng {23};
+    std::uniform_int_distribution<std::int32_t> numer {std::numeric_limits<std::int32_t>::min(), max32};
+    std::uniform_int_distribution<std::uint32_t> denom {1, std::numeric_limits<std::uint32_t>::max()};
+    for(int i {0}; i < 1000; ++i)
+    {
+        f32 x {numer(rng), rng() % 2 ? static_cast<std::uint32_t>(rng() % 1000 + 1) : denom(rng)};
+        f32 y {(numer(rng) >> (rng() % 32)) | 1, denom(rng)};
+        sss::wide::int128_t xn {x.get_numer()};
+        sss::wide::int128_t yn {y.get_numer()};
+        sss::wide::int128_t xd {x.get_denom()};
+        sss::wide::int128_t yd {y.get_denom()};
+        arithmetic::exact sum {arithmetic::reduce({xn*yd + yn*xd, xd*yd})};
+        arithmetic::exact product {arithmetic::reduce({xn*yn, xd*yd})};
+        assert_eq((af{x} + af{y}).get_numer(), sum.numer);
+        assert_eq((af{x} + af{y}).get_denom(), static_cast<sss::wide::uint128_t>(sum.denom));
+        assert_eq((af{x}*af{y}).get_numer(), product.numer);
+        assert_eq((af{x}*af{y}).get_denom(), static_cast<sss::wide::uint128_t>(product.denom));
+        assert_eq((af{x}*af{y}/af{y}), af{x});
+    }
+    assert_eq(sss::test_inexact(), false);
+
+    assert_eq((af{1}/af{0}).is_infinite(), true);
+    assert_eq((c/af{0}).signum(), 1);
+    assert_eq((-c/af{0}).signum(), -1);
+    assert_eq((c/af{0}).is_infinite(), true);
+    assert_eq((c*af{f32{1, 0}}).is_infinite(), true);
+    assert_eq((c - af{f32{1, 0}}), af{f32{-1, 0}});
+    assert_eq((c*af{f32{0, 0}}).is_nan(), true);
+    assert_eq(c/af{f32{1, 0}}, af{});
+    assert_eq(af{f32{0, 0}} == af{f32{0, 0}}, false);
+    assert_eq(af{f32{1, 0}} > c, true);
+    assert_eq(sss::test_inexact(), false);
+
+    assert_eq(c*c, af{f64{max64}});
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
+    assert_eq(af{1}/c/c, af{});
+    assert_eq(sss::test_inexact(), true);
+
+    sss::clear_inexact();
+    assert_eq(static_cast<f64>(c), f64{max64});
+    assert_eq(sss::test_inexact(), true);
+    sss::clear_inexact();
+}
+
+void test_fraction_interval()
 {
-    for(T n {std::numeric_limits<T>::min()}; n != std::numeric_limits<T>::max(); ++n)
+    using interval = sss::fraction_interval<signed char>;
+    using f8 = sss::fraction<signed char>;
+    assert_eq(interval{f8{100, 3}}*interval{f8{7, 11}}, interval{f8{106, 5}, f8{85, 4}});
+    assert_eq(interval{f8{-100, 3}}*interval{f8{7, 11}}, interval{f8{-85, 4}, f8{-106, 5}});
+    assert_eq(interval{f8{100, 3}} + interval{f8{7, 11}}, interval{f8{101, 3}, f8{34}});
+    assert_eq(interval{f8{1, 200}}*interval{f8{1, 3}}, interval{f8{0}, f8{1, 255}});
+    assert_eq(interval{f8{100}}*interval{f8{3}}, interval{f8{127}, f8{1, 0}});
+    assert_eq(-interval{f8{-128}}, interval{f8{127}, f8{1, 0}});
+    assert_eq(interval{f8{1}}/interval{f8{-1}, f8{1}}, interval{f8{-1, 0}, f8{1, 0}});
+    assert_eq(interval{f8{1, 3}} + interval{f8{1, 6}}, interval{f8{1, 2}});
+    assert_eq((interval{f8{1, 3}} + interval{f8{1, 6}}).is_exact(), true);
+    assert_eq(interval{f8{0}, f8{1, 0}}*interval{f8{0}}, interval{f8{0}});
+    assert_eq((interval{f8{0, 0}} + interval{f8{1}}).is_nan(), true);
+
+    using u8 = sss::fraction<unsigned char>;
+    sss::fraction_interval<unsigned char> half {u8{1, 2}};
+    assert_eq(half - sss::fraction_interval<unsigned char>{u8{1, 255}},
+        sss::fraction_interval<unsigned char>{u8{63, 127}, u8{64, 129}});
+    assert_eq((half - sss::fraction_interval<unsigned char>{u8{1}}).is_nan(), true);
+
+    sss::fraction_interval<int> sum {sss::fraction<int>{1, 3}};
+    sum += sss::fraction<int>{1, 2147483647};
+    assert_eq(sum.contains(sss::fraction<int>{1, 3}), false);
+    assert_eq(sum.width(), sss::fraction<int>{1, 4294967295u});
+    sss::fraction_interval<long long> big {std::numeric_limits<sss::fraction<long long>>::max()};
+    assert_eq((big + big).get_upper().is_infinite(), true);
+    assert_eq((big*big).get_lower(), big.get_lower());
+
+    auto below = [](f8 x, long long p, long long q)
+    {
+        return x.get_denom() == 0 ? x.get_numer() < 0 : x.get_numer()*q <= p*x.get_denom();
+    };
+    auto above = [](f8 x, long long p, long long q)
     {
-        for(
-            std::make_unsigned_t<T> d {std::numeric_limits<std::make_unsigned_t<T>>::min()};
-            d != std::numeric_limits<std::make_unsigned_t<T>>::max();
-            ++d
-        )
+        return x.get_denom() == 0 ? x.get_numer() > 0 : x.get_numer()*q >= p*x.get_denom();
+    };
+    for(int a {-128}; a < 128; a += 17)
+    {
+        for(int b {1}; b < 256; b += 29)
         {
-            sss::fraction<T> f {n, d};
-            if(f.get_numer() == n && f.get_denom() == d)
+            for(int c {-128}; c < 128; c += 19)
             {
-                (void)f.recip();
-                (void)f.floor();
-                (void)f.ceil();
-                (void)f.round();
-                (void)f.trunc();
-                (void)f.fract();
-                (void)f.pow(2);
-                (void)(-f);
-                for(T n2 {std::numeric_limits<T>::min()}; n2 != std::numeric_limits<T>::max(); ++n2)
+                for(int d {1}; d < 256; d += 31)
                 {
-                    (void)(f + n2);
-                    (void)(f - n2);
-                    (void)(f % n2);
-                    (void)(f * n2);
-                    (void)(f / n2);
-                    (void)(n2 + f);
-                    (void)(n2 - f);
-                    (void)(n2 % f);
-                    (void)(n2 * f);
-                    (void)(n2 / f);
-                    for(
-                        std::make_unsigned_t<T> d2 {std::numeric_limits<std::make_unsigned_t<T>>::min()};
-                        d2 != std::numeric_limits<std::make_unsigned_t<T>>::max();
-                        ++d2
-                    )
+                    interval x {f8{static_cast<signed char>(a), static_cast<unsigned char>(b)}};
+                    interval y {f8{static_cast<signed char>(c), static_cast<unsigned char>(d)}};
+                    int sign {c < 0 ? -1 : 1};
+                    long long exact[4][2] {{a*d + c*b, b*d}, {a*d - c*b, b*d}, {a*c, b*d}, {a*d*sign, b*c*sign}};
+                    interval r[4] {x + y, x - y, x*y, x/y};
+                    for(int i {0}; i < (c == 0 ? 3 : 4); ++i)
                     {
-                        sss::fraction<T> t {n2, d2};
-                        if(t.get_numer() == n2 && t.get_denom() == d2)
-                        {
-                            (void)(f + t);
-                            (void)(f - t);
-                            (void)(f % t);
-                            (void)(f * t);
-                            (void)(f / t);
-                        }
+                        assert_eq(below(r[i].get_lower(), exact[i][0], exact[i][1]), true);
+                        assert_eq(above(r[i].get_upper(), exact[i][0], exact[i][1]), true);
                     }
                 }
             }
@@ -310,6 +1437,35 @@ void test_all()
     }
 }
 
+template<typename T>
+void test_fraction_file()
+{
+    static_assert(std::ranges::random_access_range<sss::fraction_view<T>>);
+    static_assert(std::ranges::view<sss::fraction_view<T>>);
+    std::string path {(std::filesystem::temp_directory_path() / "sss_fraction_test.frac").string()};
+    std::vector<sss::fraction<T>> values {{4, 3}, {2, 6}, {0}, {1, 0}, {0, 0}, std::numeric_limits<sss::fraction<T>>::max()};
+    for(T i {1}; i < 100; ++i)
+    {
+        values.push_back({i, static_cast<std::make_unsigned_t<T>>(i + 1)});
+    }
+    assert_eq(sss::write_fraction_file<T>(path, values), true);
+    std::optional<sss::mapped_fraction_file<T>> file {sss::mapped_fraction_file<T>::open(path)};
+    assert_eq(file.has_value(), true);
+    assert_eq(file->size(), values.size());
+    for(std::size_t i {0}; i < values.size(); ++i)
+    {
+        assert_eq((*file)[i].get_numer(), values[i].get_numer());
+        assert_eq((*file)[i].get_denom(), values[i].get_denom());
+    }
+    assert_eq(std::ranges::equal(file->view().subview(6, 3), std::span{values}.subspan(6, 3)), true);
+    assert_eq(reinterpret_cast<std::uintptr_t>(file->view().get_denoms().data()) % sss::fraction_file_alignment, 0u);
+    if(std::is_signed<T>::value)
+    {
+        assert_eq(sss::mapped_fraction_file<std::make_unsigned_t<T>>::open(path).has_value(), false);
+    }
+    std::filesystem::remove(path);
+}
+
 int main()
 {
     test<char>();
@@ -323,12 +1479,71 @@ int main()
     test<long long>();
     test<unsigned long long>();
 
-    //test_all<char>();
-    
+    test_lut();
+
+    test_cia();
+    test_stats();
+    test_status();
+    test_continued_fraction();
+    test_farey();
+    test_sort();
+    test_fixed_fraction();
+    test_rescale();
+    test_quantize();
+    test_fused();
+    test_lazy();
+    test_atomic_fraction<int>();
+    test_atomic_fraction<long long>();
+    test_sharded_fraction_sum();
+    test_packed_fraction();
+    test_adaptive_fraction();
+    test_fraction_interval();
+
+    test_fraction_file<short>();
+    test_fraction_file<long long>();
+
     constexpr sss::fraction<int> A {3, 5};
     constexpr sss::fraction<int> B {-2, 6};
     constexpr sss::fraction<int> C {A%B};
 
     constexpr int N {C.get_numer()};
     constexpr unsigned int D {C.get_denom()};
+
+    using namespace sss::literals;
+    static_assert("3/5"_fr == A);
+    static_assert("-2/6"_fr == B);
+    static_assert("0.125"_fr == sss::fraction<int>{1, 8});
+    static_assert("-1.50"_fr == sss::fraction<int>{-3, 2});
+    static_assert("0.5000000000000000000"_fr8 == sss::fraction<std::int8_t>{1, 2});
+    static_assert("7/48000"_fr64.get_denom() == 48000);
+    static_assert("1.5/3"_fr16 == sss::fraction<std::int16_t>{1, 2});
+    static_assert("-128"_fr8.get_numer() == -128);
+    static_assert("255/254"_ufr8.get_numer() == 255);
+    static_assert("1/0"_fr.is_infinite());
+
+    constexpr auto quotients {[]()
+    {
+        std::array<long long, 4> a {};
+        std::size_t i {0};
+        for(long long q : sss::partial_quotients("415/93"_fr))
+        {
+            a[i++] = q;
+        }
+        return a;
+    }()};
+    static_assert(quotients == std::array<long long, 4>{4, 2, 6, 7});
+    static_assert(*std::ranges::next(sss::convergents("415/93"_fr).begin(), 2) == sss::fraction<int>{58, 13});
+    static_assert(sss::sqrt("2"_fr, 1000u) == sss::fraction<int>{1393, 985});
+    static_assert(std::ranges::distance(sss::farey(8)) == 23);
+    static_assert((sss::fixed_fraction<int, 48000>::from_ticks(1) + sss::fixed_fraction<int, 44100>::from_ticks(1))
+        .get_ticks() == 307);
+    static_assert(sss::simplest_between("0.3"_fr, "0.35"_fr) == sss::fraction<int>{1, 3});
+    static_assert(sss::rescale(1001, "1/30000"_fr, "1/90000"_fr, sss::rounding::floor) == 3003);
+    static_assert(sss::quantize_ticks("0.3"_fr, 24u, sss::rounding::nearest_even) == 7);
+    static_assert(sss::fma("1/3"_fr, "3/4"_fr, "1/6"_fr) == sss::fraction<int>{5, 12});
+    static_assert(sss::fraction<int>{(sss::lazy("1/3"_fr) + "1/6"_fr)*2} == 1);
+    static_assert(sss::atomic_fraction<int>::is_always_lock_free);
+    static_assert(sizeof(sss::packed_fraction<32, 20>) == 4);
+    static_assert((sss::packed_fraction<32, 20>{"1/3"_fr} + sss::packed_fraction<32, 20>{"1/6"_fr}).get_denom() == 2);
+    static_assert((sss::adaptive_fraction{std::numeric_limits<std::int32_t>::max()} + 1).get_width() == 64);
 }
\ No newline at end of file
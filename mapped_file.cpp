@@ -0,0 +1,131 @@
+#include "mapped_file.hpp"
+
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sss
+{
+    inline mapped_file::mapped_file(const std::byte* data, std::size_t size) noexcept:
+        data{data},
+        size{size}
+    {
+
+    }
+    inline mapped_file::mapped_file(mapped_file&& other) noexcept:
+        data{std::exchange(other.data, nullptr)},
+        size{std::exchange(other.size, 0)}
+    {
+
+    }
+    inline mapped_file::~mapped_file(void) noexcept
+    {
+        if(this->data == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(this->data);
+#else
+        munmap(const_cast<std::byte*>(this->data), this->size);
+#endif
+    }
+
+    inline mapped_file& mapped_file::operator=(mapped_file&& rhs) noexcept
+    {
+        if(this != &rhs)
+        {
+            mapped_file old {std::move(*this)};
+            this->data = std::exchange(rhs.data, nullptr);
+            this->size = std::exchange(rhs.size, 0);
+        }
+        return *this;
+    }
+
+    inline std::optional<mapped_file> mapped_file::open(const std::string& path) noexcept
+    {
+#if defined(_WIN32)
+        HANDLE file {CreateFileA(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        )};
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return std::nullopt;
+        }
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return std::nullopt;
+        }
+        if(size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return mapped_file{nullptr, 0};
+        }
+        HANDLE mapping {CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+        CloseHandle(file);
+        if(mapping == nullptr)
+        {
+            return std::nullopt;
+        }
+        const void* data {MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+        CloseHandle(mapping);
+        if(data == nullptr)
+        {
+            return std::nullopt;
+        }
+        return mapped_file{static_cast<const std::byte*>(data), static_cast<std::size_t>(size.QuadPart)};
+#else
+        int fd {::open(path.c_str(), O_RDONLY)};
+        if(fd < 0)
+        {
+            return std::nullopt;
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0)
+        {
+            close(fd);
+            return std::nullopt;
+        }
+        if(info.st_size == 0)
+        {
+            close(fd);
+            return mapped_file{nullptr, 0};
+        }
+        void* data {mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+        close(fd);
+        if(data == MAP_FAILED)
+        {
+            return std::nullopt;
+        }
+        madvise(data, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+        return mapped_file{static_cast<const std::byte*>(data), static_cast<std::size_t>(info.st_size)};
+#endif
+    }
+
+    inline const std::byte* mapped_file::get_data(void) const noexcept
+    {
+        return this->data;
+    }
+    inline std::size_t mapped_file::get_size(void) const noexcept
+    {
+        return this->size;
+    }
+}
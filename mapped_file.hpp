@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace sss
+{
+    class mapped_file
+    {
+        private:
+            const std::byte* data;
+            std::size_t size;
+
+            mapped_file(const std::byte* data, std::size_t size) noexcept;
+
+        public:
+            mapped_file(const mapped_file&) = delete;
+            mapped_file(mapped_file&& other) noexcept;
+            ~mapped_file(void) noexcept;
+
+            mapped_file& operator=(const mapped_file&) = delete;
+            mapped_file& operator=(mapped_file&& rhs) noexcept;
+
+            [[nodiscard]] static std::optional<mapped_file> open(const std::string& path) noexcept;
+
+            [[nodiscard]] const std::byte* get_data(void) const noexcept;
+            [[nodiscard]] std::size_t get_size(void) const noexcept;
+    };
+}
+
+#include "mapped_file.cpp"
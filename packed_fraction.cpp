@@ -0,0 +1,226 @@
+#include "packed_fraction.hpp"
+
+namespace sss
+{
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>::packed_fraction(void) noexcept:
+        bits{encode(0, 1)}
+    {
+
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>::packed_fraction(const fraction<value_type>& x) noexcept:
+        bits{0}
+    {
+        std::optional<packed_fraction> y {pack(x)};
+        if(!y)
+        {
+            using arithmetic = fused_arithmetic<value_type>;
+            y = pack(arithmetic::template narrow<max_numer, max_denom>(
+                typename arithmetic::exact {x.get_numer(), x.get_denom()}
+            ));
+        }
+        this->bits = y->bits;
+    }
+
+    // Infinities pack with a numerator of +-1, whatever the magnitude they were made with.
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr std::optional<packed_fraction<Bits, NumerBits>> packed_fraction<Bits, NumerBits>::pack(
+        const fraction<value_type>& x
+    ) noexcept
+    {
+        if(!x.is_finite())
+        {
+            return from_bits(encode(x.signum(), 0));
+        }
+        if(x.get_numer() < min_numer || x.get_numer() > max_numer || x.get_denom() > max_denom)
+        {
+            return std::nullopt;
+        }
+        return from_bits(encode(x.get_numer(), x.get_denom()));
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::from_bits(word_t bits) noexcept
+    {
+        packed_fraction x {};
+        x.bits = bits;
+        return x;
+    }
+
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr typename packed_fraction<Bits, NumerBits>::word_t packed_fraction<Bits, NumerBits>::get_bits(
+        void
+    ) const noexcept
+    {
+        return this->bits;
+    }
+    // The arithmetic shift of the word as a signed value brings the numerator down with its sign.
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr typename packed_fraction<Bits, NumerBits>::value_type packed_fraction<Bits, NumerBits>::get_numer(
+        void
+    ) const noexcept
+    {
+        return static_cast<value_type>(static_cast<value_type>(this->bits) >> denom_bits);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr std::make_unsigned_t<typename packed_fraction<Bits, NumerBits>::value_type>
+        packed_fraction<Bits, NumerBits>::get_denom(void) const noexcept
+    {
+        return static_cast<std::make_unsigned_t<value_type>>(this->bits & max_denom);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr bool packed_fraction<Bits, NumerBits>::is_nan(void) const noexcept
+    {
+        return this->bits == 0;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr bool packed_fraction<Bits, NumerBits>::is_infinite(void) const noexcept
+    {
+        return this->bits != 0 && this->get_denom() == 0;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr bool packed_fraction<Bits, NumerBits>::is_finite(void) const noexcept
+    {
+        return this->get_denom() != 0;
+    }
+
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr fraction<typename packed_fraction<Bits, NumerBits>::value_type> packed_fraction<Bits, NumerBits>::unpack(
+        void
+    ) const noexcept
+    {
+        return fraction<value_type>{reduced, this->get_numer(), this->get_denom()};
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>::operator fraction<value_type>(void) const noexcept
+    {
+        return this->unpack();
+    }
+
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::operator+(
+        const packed_fraction& rhs
+    ) const noexcept
+    {
+        auto op = [](const fraction<value_type>& a, const fraction<value_type>& b)
+        {
+            return a + b;
+        };
+        return combine(*this, rhs, fused_arithmetic<value_type>::add, op);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::operator-(
+        const packed_fraction& rhs
+    ) const noexcept
+    {
+        auto op = [](const fraction<value_type>& a, const fraction<value_type>& b)
+        {
+            return a - b;
+        };
+        return combine(*this, rhs, fused_arithmetic<value_type>::sub, op);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::operator*(
+        const packed_fraction& rhs
+    ) const noexcept
+    {
+        auto op = [](const fraction<value_type>& a, const fraction<value_type>& b)
+        {
+            return a*b;
+        };
+        return combine(*this, rhs, fused_arithmetic<value_type>::mul, op);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::operator/(
+        const packed_fraction& rhs
+    ) const noexcept
+    {
+        auto op = [](const fraction<value_type>& a, const fraction<value_type>& b)
+        {
+            return a/b;
+        };
+        return combine(*this, rhs, fused_arithmetic<value_type>::div, op);
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::operator-(void) const noexcept
+    {
+        return packed_fraction{-this->unpack()};
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>& packed_fraction<Bits, NumerBits>::operator+=(
+        const packed_fraction& rhs
+    ) noexcept
+    {
+        return *this = *this + rhs;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>& packed_fraction<Bits, NumerBits>::operator-=(
+        const packed_fraction& rhs
+    ) noexcept
+    {
+        return *this = *this - rhs;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>& packed_fraction<Bits, NumerBits>::operator*=(
+        const packed_fraction& rhs
+    ) noexcept
+    {
+        return *this = *this*rhs;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr packed_fraction<Bits, NumerBits>& packed_fraction<Bits, NumerBits>::operator/=(
+        const packed_fraction& rhs
+    ) noexcept
+    {
+        return *this = *this/rhs;
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr std::partial_ordering packed_fraction<Bits, NumerBits>::operator<=>(
+        const packed_fraction& rhs
+    ) const noexcept
+    {
+        return this->unpack() <=> rhs.unpack();
+    }
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr bool packed_fraction<Bits, NumerBits>::operator==(const packed_fraction& rhs) const noexcept
+    {
+        return this->unpack() == rhs.unpack();
+    }
+
+    // Both operands go into the wide accumulator of fused_arithmetic, so the result is exact until it is rounded once
+    // to the split. Non-finite operands, division by zero, and the rare 64-bit result that overflows the accumulator
+    // go through the operators of fraction<value_type> instead.
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    template<typename F, typename G>
+    constexpr packed_fraction<Bits, NumerBits> packed_fraction<Bits, NumerBits>::combine(
+        const packed_fraction& a,
+        const packed_fraction& b,
+        F exact_op,
+        G op
+    ) noexcept
+    {
+        using arithmetic = fused_arithmetic<value_type>;
+        if(a.is_finite() && b.is_finite())
+        {
+            std::optional<typename arithmetic::exact> x {exact_op(
+                {a.get_numer(), a.get_denom()},
+                {b.get_numer(), b.get_denom()}
+            )};
+            if(x)
+            {
+                fraction<value_type> y {arithmetic::template narrow<max_numer, max_denom>(*x)};
+                return from_bits(encode(y.get_numer(), y.get_denom()));
+            }
+        }
+        return packed_fraction{op(a.unpack(), b.unpack())};
+    }
+
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    constexpr typename packed_fraction<Bits, NumerBits>::word_t packed_fraction<Bits, NumerBits>::encode(
+        value_type numer,
+        std::make_unsigned_t<value_type> denom
+    ) noexcept
+    {
+        return static_cast<word_t>(static_cast<word_t>(numer) << denom_bits) | static_cast<word_t>(denom);
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "fused.hpp"
+#include "status.hpp"
+
+namespace sss
+{
+    template<std::size_t Bits, std::size_t NumerBits>
+    concept packed_split = (Bits == 32 || Bits == 64) && NumerBits >= 2 && NumerBits < Bits;
+
+    // A fraction packed into one 32- or 64-bit word: a two's complement numerator in the top NumerBits bits and the
+    // denominator in the rest, so that packed_fraction<32, 20> holds numerators in [-2^19, 2^19) and denominators up
+    // to 4095 in half the space of fraction<int>. Values are kept reduced, with the same encodings of infinity and
+    // NaN as fraction<T>, and unpack exactly to fraction<value_type>.
+    //
+    // Arithmetic unpacks, operates exactly and packs again. A result that does not fit the split is replaced by the
+    // nearest value that does, raising the inexact flag, as fraction<T> itself does on overflow.
+    template<std::size_t Bits, std::size_t NumerBits> requires packed_split<Bits, NumerBits>
+    class packed_fraction
+    {
+        public:
+            using word_t = std::conditional_t<Bits == 32, std::uint32_t, std::uint64_t>;
+            using value_type = std::conditional_t<Bits == 32, std::int32_t, std::int64_t>;
+
+            static constexpr std::size_t numer_bits {NumerBits};
+            static constexpr std::size_t denom_bits {Bits - NumerBits};
+            static constexpr value_type max_numer {static_cast<value_type>((word_t{1} << (NumerBits - 1)) - 1)};
+            static constexpr value_type min_numer {static_cast<value_type>(-max_numer - 1)};
+            static constexpr std::make_unsigned_t<value_type> max_denom {
+                static_cast<std::make_unsigned_t<value_type>>((word_t{1} << denom_bits) - 1)
+            };
+
+        private:
+            word_t bits;
+
+        public:
+            constexpr packed_fraction(void) noexcept;
+            // x, or the nearest value that fits, raising the inexact flag.
+            constexpr explicit packed_fraction(const fraction<value_type>& x) noexcept;
+
+            // x when it fits exactly, otherwise nothing.
+            [[nodiscard]] static constexpr std::optional<packed_fraction> pack(const fraction<value_type>& x) noexcept;
+            // The value whose get_bits() is `bits`.
+            [[nodiscard]] static constexpr packed_fraction from_bits(word_t bits) noexcept;
+
+            [[nodiscard]] constexpr word_t get_bits(void) const noexcept;
+            [[nodiscard]] constexpr value_type get_numer(void) const noexcept;
+            [[nodiscard]] constexpr std::make_unsigned_t<value_type> get_denom(void) const noexcept;
+            [[nodiscard]] constexpr bool is_nan(void) const noexcept;
+            [[nodiscard]] constexpr bool is_infinite(void) const noexcept;
+            [[nodiscard]] constexpr bool is_finite(void) const noexcept;
+
+            [[nodiscard]] constexpr fraction<value_type> unpack(void) const noexcept;
+            [[nodiscard]] constexpr operator fraction<value_type>(void) const noexcept;
+
+            [[nodiscard]] constexpr packed_fraction operator+(const packed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr packed_fraction operator-(const packed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr packed_fraction operator*(const packed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr packed_fraction operator/(const packed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr packed_fraction operator-(void) const noexcept;
+            constexpr packed_fraction& operator+=(const packed_fraction& rhs) noexcept;
+            constexpr packed_fraction& operator-=(const packed_fraction& rhs) noexcept;
+            constexpr packed_fraction& operator*=(const packed_fraction& rhs) noexcept;
+            constexpr packed_fraction& operator/=(const packed_fraction& rhs) noexcept;
+            [[nodiscard]] constexpr std::partial_ordering operator<=>(const packed_fraction& rhs) const noexcept;
+            [[nodiscard]] constexpr bool operator==(const packed_fraction& rhs) const noexcept;
+
+        private:
+            template<typename F, typename G>
+            [[nodiscard]] static constexpr packed_fraction combine(
+                const packed_fraction& a,
+                const packed_fraction& b,
+                F exact_op,
+                G op
+            ) noexcept;
+            [[nodiscard]] static constexpr word_t encode(
+                value_type numer,
+                std::make_unsigned_t<value_type> denom
+            ) noexcept;
+    };
+}
+
+#include "packed_fraction.cpp"
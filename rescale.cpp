@@ -0,0 +1,263 @@
+#include "rescale.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<T> rescale(
+        const T& a,
+        const fraction<T>& from,
+        const fraction<T>& to,
+        rounding mode
+    ) noexcept
+    {
+        return rescaler<T>::rescale(a, from, to, mode);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<T> quantize_ticks(const fraction<T>& x, std::make_unsigned_t<T> n, rounding mode) noexcept
+    {
+        return rescaler<T>::quantize_ticks(x, n, mode);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<fraction<T>> quantize(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> n,
+        rounding mode
+    ) noexcept
+    {
+        std::optional<T> k {rescaler<T>::quantize_ticks(x, n, mode)};
+        if(!k)
+        {
+            return std::nullopt;
+        }
+        return fraction<T>{*k, n};
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool quantize_ticks(
+        std::span<const fraction<T>> x,
+        std::make_unsigned_t<T> n,
+        rounding mode,
+        std::span<T> ticks
+    ) noexcept
+    {
+        return rescaler<T>::quantize_ticks(x, n, mode, ticks);
+    }
+
+    // The ratio from/to is formed in the wider type without a gcd. Only when it is too large for a*ratio to fit are
+    // the numerators and the denominators cancelled against each other, which for any real pair of timebases brings
+    // it back to a single division.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<T> rescaler<T>::rescale(
+        T a,
+        const fraction<T>& from,
+        const fraction<T>& to,
+        rounding mode
+    ) noexcept
+    {
+        if(!from.is_finite() || !to.is_finite() || to.is_zero())
+        {
+            return std::nullopt;
+        }
+        bool negative {false};
+        if constexpr(std::is_signed_v<T>)
+        {
+            negative = ((a < 0) != (from.get_numer() < 0)) != (to.get_numer() < 0);
+        }
+        magnitude_t from_numer {magnitude(from.get_numer())};
+        magnitude_t to_numer {magnitude(to.get_numer())};
+        wide_t numer {wide_t{from_numer}*wide_t{to.get_denom()}};
+        wide_t denom {wide_t{from.get_denom()}*wide_t{to_numer}};
+        if(numer > std::numeric_limits<wide_t>::max()/std::numeric_limits<magnitude_t>::max())
+        {
+            magnitude_t numer_gcd {std::gcd(from_numer, to_numer)};
+            magnitude_t denom_gcd {std::gcd(from.get_denom(), to.get_denom())};
+            numer = wide_t{static_cast<magnitude_t>(from_numer/numer_gcd)}
+                *wide_t{static_cast<magnitude_t>(to.get_denom()/denom_gcd)};
+            denom = wide_t{static_cast<magnitude_t>(from.get_denom()/denom_gcd)}
+                *wide_t{static_cast<magnitude_t>(to_numer/numer_gcd)};
+        }
+        std::optional<quotient> q {mul_div(magnitude(a), numer, denom)};
+        if(!q)
+        {
+            return std::nullopt;
+        }
+        return narrow(q->quot + round_up(*q, denom, negative, mode), negative);
+    }
+    // x = p/q snaps to floor(p*n/q) or the integer after it, and p*n always fits in the wider type.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<T> rescaler<T>::quantize_ticks(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> n,
+        rounding mode
+    ) noexcept
+    {
+        if(!x.is_finite() || n == 0)
+        {
+            return std::nullopt;
+        }
+        bool negative {false};
+        if constexpr(std::is_signed_v<T>)
+        {
+            negative = x.get_numer() < 0;
+        }
+        wide_t product {wide_t{magnitude(x.get_numer())}*wide_t{n}};
+        quotient q {wide::div_mod(product, wide_t{x.get_denom()})};
+        return narrow(q.quot + round_up(q, x.get_denom(), negative, mode), negative);
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool rescaler<T>::quantize_ticks(
+        std::span<const fraction<T>> x,
+        std::make_unsigned_t<T> n,
+        rounding mode,
+        std::span<T> ticks
+    ) noexcept
+    {
+        switch(mode)
+        {
+            case rounding::floor:
+                return quantize_all<rounding::floor>(x, n, ticks);
+            case rounding::ceil:
+                return quantize_all<rounding::ceil>(x, n, ticks);
+            case rounding::nearest_even:
+                return quantize_all<rounding::nearest_even>(x, n, ticks);
+            case rounding::nearest_away:
+                return quantize_all<rounding::nearest_away>(x, n, ticks);
+            case rounding::toward_zero:
+                return quantize_all<rounding::toward_zero>(x, n, ticks);
+        }
+        return false;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    constexpr typename rescaler<T>::magnitude_t rescaler<T>::magnitude(T x) noexcept
+    {
+        if constexpr(std::is_signed_v<T>)
+        {
+            if(x < 0)
+            {
+                return static_cast<magnitude_t>(magnitude_t{0} - static_cast<magnitude_t>(x));
+            }
+        }
+        return static_cast<magnitude_t>(x);
+    }
+
+    // Every mode's answer is computed and one is picked by index, so there is no switch on the mode, and a constant
+    // mode folds the others away.
+    template<typename T> requires nonbool_integral<T>
+    constexpr bool rescaler<T>::round_up(const quotient& q, wide_t denom, bool negative, rounding mode) noexcept
+    {
+        bool inexact {q.rem != 0};
+        bool above_half {q.rem > denom - q.rem};
+        bool half {q.rem == denom - q.rem};
+        bool odd {q.quot % 2 != 0};
+        const bool up[] {
+            inexact && negative,
+            inexact && !negative,
+            above_half || (half && odd),
+            above_half || half,
+            false
+        };
+        return up[static_cast<std::size_t>(mode)];
+    }
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<T> rescaler<T>::narrow(wide_t x, bool negative) noexcept
+    {
+        wide_t limit {wide_t{std::numeric_limits<T>::max()} + wide_t{negative && std::is_signed_v<T>}};
+        if(x > limit)
+        {
+            return std::nullopt;
+        }
+        if(negative)
+        {
+            return static_cast<T>(magnitude_t{0} - static_cast<magnitude_t>(x));
+        }
+        return static_cast<T>(x);
+    }
+
+    // The same steps as the scalar quantize_ticks(), with the checks turned into masks: a non-finite element divides
+    // by 1 instead of 0 and is zeroed afterwards, as is one whose tick count does not fit.
+    template<typename T> requires nonbool_integral<T>
+    template<rounding Mode>
+    constexpr bool rescaler<T>::quantize_all(std::span<const fraction<T>> x, magnitude_t n, std::span<T> ticks) noexcept
+    {
+        constexpr wide_t max {std::numeric_limits<T>::max()};
+        bool all {n != 0};
+        for(std::size_t i {0}; i < x.size(); ++i)
+        {
+            bool negative {false};
+            if constexpr(std::is_signed_v<T>)
+            {
+                negative = x[i].get_numer() < 0;
+            }
+            wide_t denom {wide_t{x[i].get_denom()} | wide_t{x[i].get_denom() == 0}};
+            wide_t product {wide_t{magnitude(x[i].get_numer())}*wide_t{n}};
+            quotient q {wide::div_mod(product, denom)};
+            wide_t k {q.quot + wide_t{round_up(q, denom, negative, Mode)}};
+            bool ok {x[i].get_denom() != 0 && k <= max + wide_t{negative && std::is_signed_v<T>}};
+            magnitude_t mask {static_cast<magnitude_t>(magnitude_t{0} - magnitude_t{negative})};
+            magnitude_t value {static_cast<magnitude_t>((static_cast<magnitude_t>(k) ^ mask) - mask)};
+            ticks[i] = static_cast<T>(value & static_cast<magnitude_t>(magnitude_t{0} - magnitude_t{ok}));
+            all &= ok;
+        }
+        return all;
+    }
+
+    // When a*b can exceed the wider type, the product is built up one bit of a at a time as a quotient and a
+    // remainder modulo c, doubling both and then adding b's own quotient and remainder for each set bit. The
+    // remainder stays below c throughout, so nothing wider than the wider type is needed.
+    template<typename T> requires nonbool_integral<T>
+    constexpr std::optional<typename rescaler<T>::quotient> rescaler<T>::mul_div(
+        magnitude_t a,
+        wide_t b,
+        wide_t c
+    ) noexcept
+    {
+        constexpr wide_t magnitude_max {std::numeric_limits<magnitude_t>::max()};
+        if(b <= std::numeric_limits<wide_t>::max()/magnitude_max)
+        {
+            quotient q {wide::div_mod(wide_t{a}*b, c)};
+            if(q.quot > magnitude_max)
+            {
+                return std::nullopt;
+            }
+            return q;
+        }
+        wide_t b_quot {b/c};
+        wide_t b_rem {b % c};
+        if(a != 0 && b_quot > magnitude_max)
+        {
+            return std::nullopt;
+        }
+        quotient x {0, 0};
+        for(int i {static_cast<int>(std::bit_width(a)) - 1}; i >= 0; --i)
+        {
+            x.quot *= 2;
+            if(x.rem >= c - x.rem)
+            {
+                x.rem -= c - x.rem;
+                ++x.quot;
+            }
+            else
+            {
+                x.rem *= 2;
+            }
+            if((a >> i) & 1)
+            {
+                x.quot += b_quot;
+                if(x.rem >= c - b_rem)
+                {
+                    x.rem -= c - b_rem;
+                    ++x.quot;
+                }
+                else
+                {
+                    x.rem += b_rem;
+                }
+            }
+            if(x.quot > magnitude_max)
+            {
+                return std::nullopt;
+            }
+        }
+        return x;
+    }
+}
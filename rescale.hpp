@@ -0,0 +1,114 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    // How a quotient that falls between two integers is turned into one. The nearest modes differ only on exact
+    // halves, which go to the even neighbour or away from zero.
+    enum class rounding
+    {
+        floor,
+        ceil,
+        nearest_even,
+        nearest_away,
+        toward_zero
+    };
+
+    // A count of `a` ticks of length `from`, as a count of ticks of length `to`: a*from/to, rounded once, as in
+    // converting presentation times between timebases. The intermediate product is exact, so nothing is
+    // approximated, and there is no fraction arithmetic and no reduce() of the result. Gives nothing when either
+    // timebase is not finite, `to` is zero, or the result does not fit in T.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr std::optional<T> rescale(
+        const T& a,
+        const fraction<T>& from,
+        const fraction<T>& to,
+        rounding mode
+    ) noexcept;
+
+    // x snapped to the grid of multiples of 1/n, as the tick count k of the grid point k/n. Gives nothing when x is
+    // not finite, n is zero, or k does not fit in T.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr std::optional<T> quantize_ticks(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> n,
+        rounding mode
+    ) noexcept;
+    // The grid point k/n itself.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr std::optional<fraction<T>> quantize(
+        const fraction<T>& x,
+        std::make_unsigned_t<T> n,
+        rounding mode
+    ) noexcept;
+    // quantize_ticks() over a whole batch, with the rounding mode fixed outside the loop and no branches inside it.
+    // `ticks` must be at least as long as `x`. Elements that cannot be quantized get 0 ticks and make the result
+    // false.
+    template<typename T> requires nonbool_integral<T>
+    [[nodiscard]] constexpr bool quantize_ticks(
+        std::span<const fraction<T>> x,
+        std::make_unsigned_t<T> n,
+        rounding mode,
+        std::span<T> ticks
+    ) noexcept;
+
+    template<typename T> requires nonbool_integral<T>
+    class rescaler
+    {
+        public:
+            [[nodiscard]] static constexpr std::optional<T> rescale(
+                T a,
+                const fraction<T>& from,
+                const fraction<T>& to,
+                rounding mode
+            ) noexcept;
+            [[nodiscard]] static constexpr std::optional<T> quantize_ticks(
+                const fraction<T>& x,
+                std::make_unsigned_t<T> n,
+                rounding mode
+            ) noexcept;
+            [[nodiscard]] static constexpr bool quantize_ticks(
+                std::span<const fraction<T>> x,
+                std::make_unsigned_t<T> n,
+                rounding mode,
+                std::span<T> ticks
+            ) noexcept;
+
+        private:
+            using magnitude_t = std::make_unsigned_t<T>;
+            // At least 32 bits, so that products of two magnitudes are never promoted to int.
+            using wide_t = std::conditional_t<sizeof(T) == 1, std::uint32_t, wide::wider_t<magnitude_t>>;
+
+            using quotient = wide::quotient<wide_t>;
+
+            [[nodiscard]] static constexpr magnitude_t magnitude(T x) noexcept;
+            [[nodiscard]] static constexpr bool round_up(
+                const quotient& q,
+                wide_t denom,
+                bool negative,
+                rounding mode
+            ) noexcept;
+            [[nodiscard]] static constexpr std::optional<T> narrow(wide_t x, bool negative) noexcept;
+            template<rounding Mode>
+            [[nodiscard]] static constexpr bool quantize_all(
+                std::span<const fraction<T>> x,
+                magnitude_t n,
+                std::span<T> ticks
+            ) noexcept;
+            // floor(a*b/c) and its remainder, or nothing when the quotient exceeds magnitude_t.
+            [[nodiscard]] static constexpr std::optional<quotient> mul_div(magnitude_t a, wide_t b, wide_t c) noexcept;
+    };
+}
+
+#include "rescale.cpp"
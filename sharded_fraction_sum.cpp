@@ -0,0 +1,95 @@
+#include "sharded_fraction_sum.hpp"
+
+namespace sss
+{
+    template<typename T> requires nonbool_integral<T>
+    sharded_fraction_sum<T>::sharded_fraction_sum(std::size_t shards):
+        count{shards == 0 ? 1 : shards},
+        shards{std::make_unique<shard[]>(this->count)}
+    {
+
+    }
+
+    // The releases pair with the acquires in load(): a read that sees the new sum also sees started counted, and
+    // one that sees finished counted also sees the new sum.
+    template<typename T> requires nonbool_integral<T>
+    void sharded_fraction_sum<T>::add(const fraction<T>& x) noexcept
+    {
+        shard& s {this->shards[thread_index() % this->count]};
+        s.started.fetch_add(1, std::memory_order_relaxed);
+        static_cast<void>(s.sum.fetch_add(x, std::memory_order_release));
+        s.finished.fetch_add(1, std::memory_order_release);
+    }
+    template<typename T> requires nonbool_integral<T>
+    sharded_fraction_sum<T>& sharded_fraction_sum<T>::operator+=(const fraction<T>& x) noexcept
+    {
+        this->add(x);
+        return *this;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    fraction<T> sharded_fraction_sum<T>::load(void) const
+    {
+        std::vector<std::uint64_t> finished(this->count);
+        std::vector<fraction<T>> sums(this->count);
+        for(bool quiet {false}; !quiet; )
+        {
+            for(std::size_t i {0}; i < this->count; ++i)
+            {
+                finished[i] = this->shards[i].finished.load(std::memory_order_acquire);
+            }
+            for(std::size_t i {0}; i < this->count; ++i)
+            {
+                sums[i] = this->shards[i].sum.load(std::memory_order_acquire);
+            }
+            // No add was under way on a shard, nor began, between reading its finished count and now, so every sum
+            // held still from the last finished count read to the first started count read.
+            quiet = true;
+            for(std::size_t i {0}; i < this->count; ++i)
+            {
+                quiet = quiet && this->shards[i].started.load(std::memory_order_relaxed) == finished[i];
+            }
+            if(!quiet)
+            {
+                std::this_thread::yield();
+            }
+        }
+        for(std::size_t width {1}; width < sums.size(); width *= 2)
+        {
+            for(std::size_t i {0}; i + width < sums.size(); i += 2*width)
+            {
+                sums[i] += sums[i + width];
+            }
+        }
+        return sums.front();
+    }
+    template<typename T> requires nonbool_integral<T>
+    sharded_fraction_sum<T>::operator fraction<T>(void) const
+    {
+        return this->load();
+    }
+    template<typename T> requires nonbool_integral<T>
+    void sharded_fraction_sum<T>::reset(void) noexcept
+    {
+        for(std::size_t i {0}; i < this->count; ++i)
+        {
+            shard& s {this->shards[i]};
+            s.started.fetch_add(1, std::memory_order_relaxed);
+            s.sum.store(fraction<T>{0}, std::memory_order_release);
+            s.finished.fetch_add(1, std::memory_order_release);
+        }
+    }
+    template<typename T> requires nonbool_integral<T>
+    std::size_t sharded_fraction_sum<T>::shard_count(void) const noexcept
+    {
+        return this->count;
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    std::size_t sharded_fraction_sum<T>::thread_index(void) noexcept
+    {
+        static std::atomic<std::size_t> next {0};
+        thread_local std::size_t index {next.fetch_add(1, std::memory_order_relaxed)};
+        return index;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "atomic_fraction.hpp"
+#include "fraction.hpp"
+
+namespace sss
+{
+    // A sum that many threads add to at once. Each thread adds to its own shard, a partial sum alone on its cache
+    // line. Threads are given shards round-robin in the order they first add, and a shard is not handed back when its
+    // thread exits, so only while no more threads than shards have ever added does each writer have a line to itself
+    // and every compare_exchange succeed first time. After that threads share shards, which stays correct but costs
+    // retries.
+    //
+    // Reads merge the shards pairwise, as a balanced tree, so that sums of similar size and denominator meet first
+    // and the denominators grow no faster than they have to. Each shard counts the adds started and finished on it,
+    // and a read collects the shards between a pass over the finished counts and a pass over the started counts,
+    // trying again until they match. It therefore returns the sum as it stood at one instant, with every add either
+    // fully in or fully out, but may retry for as long as adds keep arriving.
+    template<typename T> requires nonbool_integral<T>
+    class sharded_fraction_sum
+    {
+        private:
+            static constexpr std::size_t cache_line {64};
+
+            struct alignas(cache_line) shard
+            {
+                atomic_fraction<T> sum;
+                std::atomic<std::uint64_t> started {0};
+                std::atomic<std::uint64_t> finished {0};
+            };
+
+            std::size_t count;
+            std::unique_ptr<shard[]> shards;
+
+        public:
+            // One shard per hardware thread by default.
+            explicit sharded_fraction_sum(std::size_t shards = std::thread::hardware_concurrency());
+            sharded_fraction_sum(const sharded_fraction_sum&) = delete;
+            sharded_fraction_sum& operator=(const sharded_fraction_sum&) = delete;
+
+            void add(const fraction<T>& x) noexcept;
+            sharded_fraction_sum& operator+=(const fraction<T>& x) noexcept;
+            [[nodiscard]] fraction<T> load(void) const;
+            [[nodiscard]] operator fraction<T>(void) const;
+            // Sets every shard back to zero, one shard at a time. Adds that race with it may land on either side.
+            void reset(void) noexcept;
+            [[nodiscard]] std::size_t shard_count(void) const noexcept;
+
+        private:
+            [[nodiscard]] static std::size_t thread_index(void) noexcept;
+    };
+}
+
+#include "sharded_fraction_sum.cpp"
@@ -0,0 +1,123 @@
+#include "sort.hpp"
+
+namespace sss
+{
+    template<typename R> requires fraction_range<R>
+    void sort(R&& x)
+    {
+        using T = decltype(std::declval<std::ranges::range_value_t<R>>().get_numer());
+        fraction_sorter<T>::sort(std::ranges::begin(x), std::ranges::begin(x) + std::ranges::ssize(x), 1);
+    }
+    template<typename R> requires fraction_range<R>
+    void parallel_sort(R&& x, std::size_t threads)
+    {
+        using T = decltype(std::declval<std::ranges::range_value_t<R>>().get_numer());
+        fraction_sorter<T>::sort(std::ranges::begin(x), std::ranges::begin(x) + std::ranges::ssize(x), threads);
+    }
+
+    template<typename T> requires nonbool_integral<T>
+    template<typename I> requires std::random_access_iterator<I>
+    void fraction_sorter<T>::sort(I first, I last, std::size_t threads)
+    {
+        I finite {std::partition(first, last, [](const fraction<T>& x)
+        {
+            return x.is_infinite() && x.get_numer() < 0;
+        })};
+        I infinite {std::partition(finite, last, [](const fraction<T>& x)
+        {
+            return x.is_finite();
+        })};
+        std::partition(infinite, last, [](const fraction<T>& x)
+        {
+            return !x.is_nan();
+        });
+        threads = std::min(threads, static_cast<std::size_t>(infinite - finite)/min_parallel_chunk);
+        if(threads < 2)
+        {
+            std::sort(finite, infinite, less{});
+            return;
+        }
+        parallel_sort(finite, infinite, threads);
+    }
+
+    // Both cross products fit in the wider type: a 64-bit numerator times a 64-bit denominator is below 2^127 in
+    // magnitude when the numerator is signed and below 2^128 when it is not.
+    template<typename T> requires nonbool_integral<T>
+    bool fraction_sorter<T>::less::operator()(const fraction<T>& a, const fraction<T>& b) const noexcept
+    {
+        using W = wide::wider_t<T>;
+        return W{a.get_numer()}*W{b.get_denom()} < W{b.get_numer()}*W{a.get_denom()};
+    }
+
+    // Sorted runs are merged pairwise, from the range into a buffer and back, so each round moves the data once.
+    template<typename T> requires nonbool_integral<T>
+    template<typename I> requires std::random_access_iterator<I>
+    void fraction_sorter<T>::parallel_sort(I first, I last, std::size_t threads)
+    {
+        std::size_t n {static_cast<std::size_t>(last - first)};
+        std::vector<fraction<T>> buffer(n);
+        auto at = [first](std::size_t i)
+        {
+            return first + static_cast<std::iter_difference_t<I>>(i);
+        };
+        auto buffer_at = [&buffer](std::size_t i)
+        {
+            return buffer.begin() + static_cast<std::ptrdiff_t>(i);
+        };
+        std::vector<std::size_t> bounds {};
+        for(std::size_t t {0}; t <= threads; ++t)
+        {
+            bounds.push_back(n*t/threads);
+        }
+
+        std::vector<std::thread> workers {};
+        for(std::size_t t {0}; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]()
+            {
+                std::sort(at(bounds[t]), at(bounds[t + 1]), less{});
+            });
+        }
+        for(std::thread& w : workers)
+        {
+            w.join();
+        }
+
+        bool in_buffer {false};
+        while(bounds.size() > 2)
+        {
+            std::vector<std::size_t> merged {};
+            workers.clear();
+            for(std::size_t i {0}; i + 1 < bounds.size(); i += 2)
+            {
+                std::size_t begin {bounds[i]};
+                std::size_t middle {bounds[i + 1]};
+                std::size_t end {bounds[std::min(i + 2, bounds.size() - 1)]};
+                merged.push_back(begin);
+                workers.emplace_back([&, begin, middle, end]()
+                {
+                    if(in_buffer)
+                    {
+                        std::merge(buffer_at(begin), buffer_at(middle), buffer_at(middle), buffer_at(end), at(begin),
+                            less{});
+                    }
+                    else
+                    {
+                        std::merge(at(begin), at(middle), at(middle), at(end), buffer_at(begin), less{});
+                    }
+                });
+            }
+            merged.push_back(n);
+            for(std::thread& w : workers)
+            {
+                w.join();
+            }
+            in_buffer = !in_buffer;
+            bounds = std::move(merged);
+        }
+        if(in_buffer)
+        {
+            std::ranges::copy(buffer, first);
+        }
+    }
+}
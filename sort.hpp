@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+namespace sss
+{
+    template<typename R>
+    concept fraction_range = std::ranges::random_access_range<R> && std::ranges::sized_range<R>
+        && std::same_as<
+            std::ranges::range_value_t<R>,
+            fraction<decltype(std::declval<std::ranges::range_value_t<R>>().get_numer())>
+        >;
+
+    // Sorts by value, in place. Unlike operator<, which cross-multiplies in T, the comparison is exact for every pair
+    // of finite fractions: the cross products are taken in twice the width of T. Negative infinities go first,
+    // positive infinities and then NaNs last, so NaNs cannot break the ordering either. The sort is not stable.
+    template<typename R> requires fraction_range<R>
+    void sort(R&& x);
+
+    // sort() on `threads` chunks at once, followed by rounds of pairwise merges, also in parallel. Ranges too small
+    // to be worth the threads are sorted on the calling thread.
+    template<typename R> requires fraction_range<R>
+    void parallel_sort(R&& x, std::size_t threads = std::thread::hardware_concurrency());
+
+    template<typename T> requires nonbool_integral<T>
+    class fraction_sorter
+    {
+        public:
+            template<typename I> requires std::random_access_iterator<I>
+            static void sort(I first, I last, std::size_t threads);
+
+            // The exact order of finite fractions that sort() uses, for other folds over them such as a minimum. A
+            // function object rather than a function, so that std::sort inlines the comparison.
+            struct less
+            {
+                [[nodiscard]] bool operator()(const fraction<T>& a, const fraction<T>& b) const noexcept;
+            };
+
+        private:
+            static constexpr std::size_t min_parallel_chunk {1u << 14};
+            template<typename I> requires std::random_access_iterator<I>
+            static void parallel_sort(I first, I last, std::size_t threads);
+    };
+}
+
+#include "sort.cpp"
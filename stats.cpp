@@ -0,0 +1,227 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef SSS_FRACTION_STATS
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace sss
+{
+    namespace stats
+    {
+        inline void counters::merge(const counters& rhs) noexcept
+        {
+            for(std::size_t i {0}; i < op_count; ++i)
+            {
+                this->calls[i] += rhs.calls[i];
+                this->checked_failures[i] += rhs.checked_failures[i];
+                this->loop_iterations[i] += rhs.loop_iterations[i];
+            }
+            this->reduce_calls += rhs.reduce_calls;
+            this->max_relative_error = std::max(this->max_relative_error, rhs.max_relative_error);
+        }
+        inline counters counters::since(const counters& earlier) const noexcept
+        {
+            counters d {*this};
+            for(std::size_t i {0}; i < op_count; ++i)
+            {
+                d.calls[i] -= earlier.calls[i];
+                d.checked_failures[i] -= earlier.checked_failures[i];
+                d.loop_iterations[i] -= earlier.loop_iterations[i];
+            }
+            d.reduce_calls -= earlier.reduce_calls;
+            return d;
+        }
+
+        constexpr bool enabled(void) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+#ifdef SSS_FRACTION_STATS
+        // Each thread owns one of these and is its only writer, so an increment is a relaxed load and store rather
+        // than a locked read-modify-write. The atomics only make concurrent snapshots well-defined.
+        struct thread_counters
+        {
+            std::array<std::atomic<std::uint64_t>, op_count> calls {};
+            std::array<std::atomic<std::uint64_t>, op_count> checked_failures {};
+            std::array<std::atomic<std::uint64_t>, op_count> loop_iterations {};
+            std::atomic<std::uint64_t> reduce_calls {0};
+            std::atomic<double> max_relative_error {0.0};
+
+            [[nodiscard]] counters load(void) const noexcept
+            {
+                counters c {};
+                for(std::size_t i {0}; i < op_count; ++i)
+                {
+                    c.calls[i] = this->calls[i].load(std::memory_order_relaxed);
+                    c.checked_failures[i] = this->checked_failures[i].load(std::memory_order_relaxed);
+                    c.loop_iterations[i] = this->loop_iterations[i].load(std::memory_order_relaxed);
+                }
+                c.reduce_calls = this->reduce_calls.load(std::memory_order_relaxed);
+                c.max_relative_error = this->max_relative_error.load(std::memory_order_relaxed);
+                return c;
+            }
+            void clear(void) noexcept
+            {
+                for(std::size_t i {0}; i < op_count; ++i)
+                {
+                    this->calls[i].store(0, std::memory_order_relaxed);
+                    this->checked_failures[i].store(0, std::memory_order_relaxed);
+                    this->loop_iterations[i].store(0, std::memory_order_relaxed);
+                }
+                this->reduce_calls.store(0, std::memory_order_relaxed);
+                this->max_relative_error.store(0.0, std::memory_order_relaxed);
+            }
+        };
+
+        struct registry
+        {
+            std::mutex mutex;
+            std::vector<thread_counters*> live;
+            counters retired;
+        };
+
+        inline registry& get_registry(void) noexcept
+        {
+            static registry r {};
+            return r;
+        }
+
+        // Registers the thread's counters on first use and folds them into `retired` when the thread exits.
+        struct thread_slot
+        {
+            thread_counters c;
+
+            thread_slot(void)
+            {
+                registry& r {get_registry()};
+                std::lock_guard<std::mutex> lock {r.mutex};
+                r.live.push_back(&this->c);
+            }
+            ~thread_slot(void)
+            {
+                registry& r {get_registry()};
+                std::lock_guard<std::mutex> lock {r.mutex};
+                r.retired.merge(this->c.load());
+                r.live.erase(std::find(r.live.begin(), r.live.end(), &this->c));
+            }
+        };
+
+        inline thread_counters& local(void) noexcept
+        {
+            thread_local thread_slot slot {};
+            return slot.c;
+        }
+
+        inline void bump(std::atomic<std::uint64_t>& x, std::uint64_t n) noexcept
+        {
+            x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+#endif
+
+        inline counters thread_snapshot(void) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            return local().load();
+#else
+            return {};
+#endif
+        }
+        inline counters snapshot(void) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            (void)local();
+            registry& r {get_registry()};
+            std::lock_guard<std::mutex> lock {r.mutex};
+            counters total {r.retired};
+            for(const thread_counters* c : r.live)
+            {
+                total.merge(c->load());
+            }
+            return total;
+#else
+            return {};
+#endif
+        }
+        inline void reset(void) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            (void)local();
+            registry& r {get_registry()};
+            std::lock_guard<std::mutex> lock {r.mutex};
+            r.retired = {};
+            for(thread_counters* c : r.live)
+            {
+                c->clear();
+            }
+#endif
+        }
+
+        constexpr void count_call([[maybe_unused]] op o) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            if !consteval
+            {
+                bump(local().calls[static_cast<std::size_t>(o)], 1);
+            }
+#endif
+        }
+        constexpr void count_reduce(void) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            if !consteval
+            {
+                bump(local().reduce_calls, 1);
+            }
+#endif
+        }
+        template<typename F>
+        constexpr void count_approximation([[maybe_unused]] op o, [[maybe_unused]] std::uint64_t iterations,
+            [[maybe_unused]] const F& lhs, [[maybe_unused]] const F& rhs, [[maybe_unused]] const F& result) noexcept
+        {
+#ifdef SSS_FRACTION_STATS
+            if !consteval
+            {
+                if(iterations == 0)
+                {
+                    return;
+                }
+                thread_counters& c {local()};
+                bump(c.checked_failures[static_cast<std::size_t>(o)], 1);
+                bump(c.loop_iterations[static_cast<std::size_t>(o)], iterations);
+
+                long double a {static_cast<long double>(lhs)};
+                long double b {static_cast<long double>(rhs)};
+                long double exact {};
+                switch(o)
+                {
+                    case op::add: exact = a + b; break;
+                    case op::sub: exact = a - b; break;
+                    case op::rem: exact = std::fmod(a, b); break;
+                    case op::mul: exact = a*b; break;
+                    case op::div: exact = a/b; break;
+                }
+                long double error {std::fabs(static_cast<long double>(result) - exact)};
+                if(exact != 0)
+                {
+                    error /= std::fabs(exact);
+                }
+                double e {static_cast<double>(error)};
+                if(std::isfinite(e) && e > c.max_relative_error.load(std::memory_order_relaxed))
+                {
+                    c.max_relative_error.store(e, std::memory_order_relaxed);
+                }
+            }
+#endif
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace sss
+{
+    namespace stats
+    {
+        // Arithmetic operators whose checked path can fail and fall through to the approximation loop.
+        enum class op : std::size_t
+        {
+            add,
+            sub,
+            rem,
+            mul,
+            div
+        };
+
+        inline constexpr std::size_t op_count {5};
+        inline constexpr std::array<const char*, op_count> op_names {"+", "-", "%", "*", "/"};
+
+        // `calls` counts every arithmetic operator call once, whether the right-hand side is a fraction or an
+        // integer. `checked_failures` counts the calls whose exact result did not fit and were approximated,
+        // `loop_iterations` the operand shrinking steps those calls took, and `max_relative_error` the worst drift
+        // of an approximated result from the exact one.
+        struct counters
+        {
+            std::array<std::uint64_t, op_count> calls {};
+            std::array<std::uint64_t, op_count> checked_failures {};
+            std::array<std::uint64_t, op_count> loop_iterations {};
+            std::uint64_t reduce_calls {0};
+            double max_relative_error {0.0};
+
+            void merge(const counters& rhs) noexcept;
+            // What happened between `earlier` and this snapshot of the same counters; max_relative_error is kept
+            // as is, since a maximum cannot be subtracted.
+            [[nodiscard]] counters since(const counters& earlier) const noexcept;
+        };
+
+        // Counting is compiled in only when SSS_FRACTION_STATS is defined. Otherwise every hook is an empty
+        // constexpr function and the snapshots are all zero.
+        [[nodiscard]] constexpr bool enabled(void) noexcept;
+
+        // Counters of the calling thread only, which is cheap and exact for attributing work to a call site.
+        [[nodiscard]] counters thread_snapshot(void) noexcept;
+        // Sum over every thread, including threads that have already exited.
+        [[nodiscard]] counters snapshot(void) noexcept;
+        // Zeroes every counter. Increments racing with a reset from another thread may be lost.
+        void reset(void) noexcept;
+
+        // Hooks called by fraction. They do nothing during constant evaluation.
+        constexpr void count_call(op o) noexcept;
+        constexpr void count_reduce(void) noexcept;
+        template<typename F>
+        constexpr void count_approximation(op o, std::uint64_t iterations, const F& lhs, const F& rhs,
+            const F& result) noexcept;
+    }
+}
+
+#include "stats.cpp"
@@ -0,0 +1,22 @@
+#include "status.hpp"
+
+namespace sss
+{
+    inline thread_local bool inexact {false};
+
+    inline bool test_inexact(void) noexcept
+    {
+        return inexact;
+    }
+    inline void clear_inexact(void) noexcept
+    {
+        inexact = false;
+    }
+    constexpr void raise_inexact(void) noexcept
+    {
+        if !consteval
+        {
+            inexact = true;
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace sss
+{
+    // A sticky, thread-local "inexact" flag in the spirit of FE_INEXACT. The operators raise it whenever an exact
+    // result did not fit and they returned an approximation instead, and so does a narrowing conversion between
+    // fraction types that had to round. Nothing ever clears it except clear_inexact(), so a whole batch of
+    // operations can be validated with a single test_inexact() at the end.
+    [[nodiscard]] bool test_inexact(void) noexcept;
+    void clear_inexact(void) noexcept;
+    // Does nothing during constant evaluation.
+    constexpr void raise_inexact(void) noexcept;
+}
+
+#include "status.cpp"
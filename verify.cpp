@@ -0,0 +1,770 @@
+// Exhaustive and sampled verification of fraction<T> against an exact 128-bit oracle.
+//
+// Build: g++ -std=c++23 -O2 -pthread verify.cpp -o verify
+//
+//   verify --type i8                          every (n, d) x every operand, all cores
+//   verify --type i16 --sample 100000000      random operand pairs, reproducible from --seed
+//   verify ... --checkpoint verify.ckpt       completed shards are recorded and skipped when rerun
+//   verify ... --save-baseline verify.base    the failures of each operation are saved as the accepted ones
+//   verify ... --baseline verify.base         only failures beyond the saved ones fail the run
+//
+// Results that are representable in the result type must match the oracle exactly. Results that are not are
+// counted as approximated, and must still be finite, of the right sign or 0, and as near to the exact value as
+// saturating would be: the limit of the type beyond its range, and 0 or the smallest magnitude below that. Within
+// the range the relative error must be at most 1/max, which the nearest fraction always achieves. Integer results
+// beyond the range must saturate. Division by zero must produce an infinity of the right sign, or NaN for 0/0. The
+// failures are summarized per operation. The exit status is non-zero if any check failed or, with --baseline, only
+// if some operation failed more often than in the baseline, which must come from the same type, sample and seed.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "fraction.hpp"
+#include "wide.hpp"
+
+using sss::wide::int128_t;
+
+constexpr std::array<const char*, 23> op_names {
+    "recip", "floor", "ceil", "trunc", "round", "fract", "pow(2)", "neg",
+    "f+i", "f-i", "f*i", "f/i", "f%i", "i+f", "i-f", "i*f", "i/f", "i%f",
+    "f+f", "f-f", "f*f", "f/f", "f%f"
+};
+
+enum op : std::size_t
+{
+    recip, floor_, ceil_, trunc_, round_, fract, pow2, neg,
+    add_i, sub_i, mul_i, div_i, rem_i, i_add, i_sub, i_mul, i_div, i_rem,
+    add_f, sub_f, mul_f, div_f, rem_f
+};
+
+struct tally
+{
+    std::uint64_t checked {0};
+    std::uint64_t exact {0};
+    std::uint64_t approximated {0};
+    double max_error {0.0};
+    std::array<std::uint64_t, op_names.size()> failures {};
+
+    std::uint64_t total_failures(void) const noexcept
+    {
+        return std::accumulate(this->failures.begin(), this->failures.end(), std::uint64_t{0});
+    }
+
+    void merge(const tally& rhs) noexcept
+    {
+        this->checked += rhs.checked;
+        this->exact += rhs.exact;
+        this->approximated += rhs.approximated;
+        this->max_error = std::max(this->max_error, rhs.max_error);
+        for(std::size_t i {0}; i < this->failures.size(); ++i)
+        {
+            this->failures[i] += rhs.failures[i];
+        }
+    }
+};
+
+struct options
+{
+    std::string type {"i8"};
+    std::uint64_t sample {0};
+    std::uint64_t seed {1};
+    unsigned threads {std::max(1u, std::thread::hardware_concurrency())};
+    std::string checkpoint {};
+    std::string baseline {};
+    std::string save_baseline {};
+    unsigned max_reports {20};
+};
+
+// Exact rational in lowest terms with a non-negative denominator. d == 0 encodes +-infinity (n = +-1) or NaN (n = 0).
+struct exact
+{
+    int128_t n;
+    int128_t d;
+
+    static exact of(int128_t n, int128_t d) noexcept
+    {
+        if(d < 0)
+        {
+            n = -n;
+            d = -d;
+        }
+        int128_t a {n < 0 ? -n : n};
+        int128_t b {d};
+        while(b != 0)
+        {
+            int128_t r {a % b};
+            a = b;
+            b = r;
+        }
+        if(a > 1)
+        {
+            n /= a;
+            d /= a;
+        }
+        return {n, d};
+    }
+};
+
+std::string to_string(int128_t x)
+{
+    if(x == 0)
+    {
+        return "0";
+    }
+    bool negative {x < 0};
+    std::string s;
+    for(; x != 0; x /= 10)
+    {
+        int digit {static_cast<int>(x % 10)};
+        s.push_back(static_cast<char>('0' + (digit < 0 ? -digit : digit)));
+    }
+    if(negative)
+    {
+        s.push_back('-');
+    }
+    std::reverse(s.begin(), s.end());
+    return s;
+}
+
+template<typename T>
+class verifier
+{
+    private:
+        using U = std::make_unsigned_t<T>;
+
+        const options& opts;
+        std::mutex& report_mutex;
+        std::atomic<unsigned>& reports;
+
+        template<typename R>
+        static bool fits(const exact& e) noexcept
+        {
+            return e.n >= static_cast<int128_t>(std::numeric_limits<R>::min())
+                && e.n <= static_cast<int128_t>(std::numeric_limits<R>::max())
+                && e.d <= static_cast<int128_t>(std::numeric_limits<std::make_unsigned_t<R>>::max());
+        }
+
+        // Whether y is an acceptable approximation of an exact x that R cannot represent.
+        template<typename R>
+        static bool approximates(long double x, long double y) noexcept
+        {
+            constexpr long double max {static_cast<long double>(std::numeric_limits<R>::max())};
+            constexpr long double min {static_cast<long double>(std::numeric_limits<R>::min())};
+            constexpr long double denom_max {
+                static_cast<long double>(std::numeric_limits<std::make_unsigned_t<R>>::max())
+            };
+            constexpr long double tiny {1.0L/denom_max};
+            if(!std::isfinite(y) || (y < 0 && x > 0) || (y > 0 && x < 0))
+            {
+                return false;
+            }
+            if(x > max || x < min)
+            {
+                return y == (x > max ? max : min);
+            }
+            long double error {std::fabs(y - x)};
+            if(std::fabs(x) < tiny)
+            {
+                return error <= std::min(std::fabs(x), tiny - std::fabs(x));
+            }
+            return error <= std::fabs(x)/max;
+        }
+
+        void report(op o, const sss::fraction<T>& a, const sss::fraction<T>* b, const std::string& expected,
+            const std::string& got) const
+        {
+            if(this->reports.fetch_add(1) >= this->opts.max_reports)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> lock {this->report_mutex};
+            std::fprintf(stderr, "FAIL %s(%s%s%s): expected %s, got %s\n", op_names[o],
+                static_cast<std::string>(a).c_str(), b == nullptr ? "" : ", ",
+                b == nullptr ? "" : static_cast<std::string>(*b).c_str(), expected.c_str(), got.c_str());
+        }
+
+        template<typename R>
+        void check(tally& t, op o, const sss::fraction<T>& a, const sss::fraction<T>* b, const exact& e,
+            const sss::fraction<R>& r) const
+        {
+            ++t.checked;
+            bool ok {true};
+            if(e.d == 0)
+            {
+                ok = e.n == 0 ? r.is_nan() : r.is_infinite() && (r.get_numer() < 0) == (e.n < 0);
+                t.exact += ok;
+            }
+            else if(fits<R>(e))
+            {
+                ok = r.get_numer() == e.n && r.get_denom() == e.d;
+                t.exact += ok;
+            }
+            else
+            {
+                ++t.approximated;
+                long double x {static_cast<long double>(e.n)/static_cast<long double>(e.d)};
+                long double y {static_cast<long double>(r)};
+                if(std::isfinite(y) && x != 0)
+                {
+                    t.max_error = std::max(t.max_error, static_cast<double>(std::fabs((y - x)/x)));
+                }
+                ok = approximates<R>(x, y);
+            }
+            if(!ok)
+            {
+                ++t.failures[o];
+                this->report(o, a, b, to_string(e.n) + "/" + to_string(e.d), static_cast<std::string>(r));
+            }
+        }
+
+        void check(tally& t, op o, const sss::fraction<T>& a, int128_t e, T r) const
+        {
+            ++t.checked;
+            constexpr int128_t min {std::numeric_limits<T>::min()};
+            constexpr int128_t max {std::numeric_limits<T>::max()};
+            if(e < min || e > max)
+            {
+                ++t.approximated;
+                if(r == (e < min ? min : max))
+                {
+                    return;
+                }
+            }
+            else if(e == r)
+            {
+                ++t.exact;
+                return;
+            }
+            ++t.failures[o];
+            this->report(o, a, nullptr, to_string(e), to_string(r));
+        }
+
+        static int128_t floor_div(int128_t a, int128_t b) noexcept
+        {
+            int128_t q {a/b};
+            return q - ((a % b != 0) && ((a < 0) != (b < 0)));
+        }
+
+        void check_unary(tally& t, const sss::fraction<T>& f) const
+        {
+            int128_t a {f.get_numer()};
+            int128_t b {f.get_denom()};
+            check(t, recip, f, nullptr, exact::of(b, a), f.recip());
+            check(t, floor_, f, floor_div(a, b), f.floor());
+            check(t, ceil_, f, -floor_div(-a, b), f.ceil());
+            check(t, trunc_, f, a/b, f.trunc());
+            int128_t away {(2*(a < 0 ? -a : a) + b)/(2*b)};
+            check(t, round_, f, a < 0 ? -away : away, f.round());
+            check(t, fract, f, nullptr, exact::of(a % b, b), f.fract());
+            check(t, pow2, f, nullptr, exact::of(a*a, b*b), f.pow(2));
+            check(t, neg, f, nullptr, exact::of(-a, b), -f);
+        }
+
+        void check_integer(tally& t, const sss::fraction<T>& f, T x) const
+        {
+            int128_t a {f.get_numer()};
+            int128_t b {f.get_denom()};
+            int128_t c {x};
+            sss::fraction<T> g {x};
+            check(t, add_i, f, &g, exact::of(a + c*b, b), f + x);
+            check(t, sub_i, f, &g, exact::of(a - c*b, b), f - x);
+            check(t, mul_i, f, &g, exact::of(a*c, b), f*x);
+            check(t, div_i, f, &g, c == 0 ? exact{a == 0 ? 0 : (a < 0 ? -1 : 1), 0} : exact::of(a, b*c), f/x);
+            check(t, rem_i, f, &g, c == 0 ? exact{0, 0} : exact::of(a % (c*b), b), f % x);
+            check(t, i_add, f, &g, exact::of(c*b + a, b), x + f);
+            check(t, i_sub, f, &g, exact::of(c*b - a, b), x - f);
+            check(t, i_mul, f, &g, exact::of(c*a, b), x*f);
+            check(t, i_div, f, &g, a == 0 ? exact{c == 0 ? 0 : (c < 0 ? -1 : 1), 0} : exact::of(c*b, a), x/f);
+            check(t, i_rem, f, &g, a == 0 ? exact{0, 0} : exact::of((c*b) % a, b), x % f);
+        }
+
+        void check_binary(tally& t, const sss::fraction<T>& f, const sss::fraction<T>& g) const
+        {
+            int128_t a {f.get_numer()};
+            int128_t b {f.get_denom()};
+            int128_t c {g.get_numer()};
+            int128_t d {g.get_denom()};
+            check(t, add_f, f, &g, exact::of(a*d + c*b, b*d), f + g);
+            check(t, sub_f, f, &g, exact::of(a*d - c*b, b*d), f - g);
+            check(t, mul_f, f, &g, exact::of(a*c, b*d), f*g);
+            check(t, div_f, f, &g, c == 0 ? exact{a == 0 ? 0 : (a < 0 ? -1 : 1), 0} : exact::of(a*d, b*c), f/g);
+            check(t, rem_f, f, &g, c == 0 ? exact{0, 0} : exact::of((a*d) % (c*b), b*d), f % g);
+        }
+
+        static std::optional<sss::fraction<T>> canonical(T n, U d) noexcept
+        {
+            sss::fraction<T> f {n, d};
+            if(f.get_numer() != n || f.get_denom() != d)
+            {
+                return std::nullopt;
+            }
+            return f;
+        }
+
+    public:
+        verifier(const options& opts, std::mutex& report_mutex, std::atomic<unsigned>& reports) noexcept:
+            opts{opts},
+            report_mutex{report_mutex},
+            reports{reports}
+        {
+
+        }
+
+        static constexpr std::uint64_t sample_shard_size {1 << 16};
+
+        std::uint64_t shard_count(void) const noexcept
+        {
+            if(this->opts.sample != 0)
+            {
+                return (this->opts.sample + sample_shard_size - 1)/sample_shard_size;
+            }
+            return std::uint64_t{std::numeric_limits<U>::max()} + 1;
+        }
+
+        // Exhaustive shards are one outer numerator each; sampled shards draw from a generator seeded by the shard
+        // index, so a resumed run checks exactly the same operands.
+        tally run_shard(std::uint64_t shard) const
+        {
+            tally t;
+            if(this->opts.sample != 0)
+            {
+                std::mt19937_64 rng {this->opts.seed*0x9E3779B97F4A7C15ull + shard};
+                std::uniform_int_distribution<long long> numer {std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+                std::uniform_int_distribution<unsigned long long> denom {1, std::numeric_limits<U>::max()};
+                std::uint64_t n {std::min(sample_shard_size, this->opts.sample - shard*sample_shard_size)};
+                for(std::uint64_t i {0}; i < n; ++i)
+                {
+                    sss::fraction<T> f {static_cast<T>(numer(rng)), static_cast<U>(denom(rng))};
+                    sss::fraction<T> g {static_cast<T>(numer(rng)), static_cast<U>(denom(rng))};
+                    this->check_unary(t, f);
+                    this->check_integer(t, f, g.get_numer());
+                    this->check_binary(t, f, g);
+                }
+                return t;
+            }
+            T n {static_cast<T>(static_cast<U>(shard))};
+            for(U d {1};; ++d)
+            {
+                std::optional<sss::fraction<T>> f {canonical(n, d)};
+                if(f.has_value())
+                {
+                    this->check_unary(t, f.value());
+                    for(T n2 {std::numeric_limits<T>::min()};; ++n2)
+                    {
+                        this->check_integer(t, f.value(), n2);
+                        for(U d2 {1};; ++d2)
+                        {
+                            std::optional<sss::fraction<T>> g {canonical(n2, d2)};
+                            if(g.has_value())
+                            {
+                                this->check_binary(t, f.value(), g.value());
+                            }
+                            if(d2 == std::numeric_limits<U>::max())
+                            {
+                                break;
+                            }
+                        }
+                        if(n2 == std::numeric_limits<T>::max())
+                        {
+                            break;
+                        }
+                    }
+                }
+                if(d == std::numeric_limits<U>::max())
+                {
+                    break;
+                }
+            }
+            return t;
+        }
+};
+
+// Work-stealing pool: every worker owns a deque of shard indices, pops from its back and, when empty, steals from
+// the front of the others.
+class scheduler
+{
+    private:
+        struct queue
+        {
+            std::mutex mutex;
+            std::deque<std::uint64_t> shards;
+        };
+
+        std::vector<queue> queues;
+
+    public:
+        scheduler(unsigned workers, const std::vector<std::uint64_t>& shards):
+            queues(workers)
+        {
+            for(std::size_t i {0}; i < shards.size(); ++i)
+            {
+                this->queues[i*workers/shards.size()].shards.push_back(shards[i]);
+            }
+        }
+
+        std::optional<std::uint64_t> next(unsigned worker)
+        {
+            {
+                queue& own {this->queues[worker]};
+                std::lock_guard<std::mutex> lock {own.mutex};
+                if(!own.shards.empty())
+                {
+                    std::uint64_t shard {own.shards.back()};
+                    own.shards.pop_back();
+                    return shard;
+                }
+            }
+            for(std::size_t i {1}; i < this->queues.size(); ++i)
+            {
+                queue& victim {this->queues[(worker + i) % this->queues.size()]};
+                std::lock_guard<std::mutex> lock {victim.mutex};
+                if(!victim.shards.empty())
+                {
+                    std::uint64_t shard {victim.shards.front()};
+                    victim.shards.pop_front();
+                    return shard;
+                }
+            }
+            return std::nullopt;
+        }
+};
+
+std::string describe(const options& opts)
+{
+    std::ostringstream s;
+    s << "type=" << opts.type << " sample=" << opts.sample << " seed=" << opts.seed;
+    return s.str();
+}
+
+// Checkpoint file: a header line describing the run, then one line per completed shard with its tally.
+std::optional<std::unordered_map<std::uint64_t, tally>> load_checkpoint(const options& opts)
+{
+    std::unordered_map<std::uint64_t, tally> done;
+    std::ifstream in {opts.checkpoint};
+    if(!in)
+    {
+        return done;
+    }
+    std::string line;
+    if(std::getline(in, line) && line != describe(opts))
+    {
+        std::fprintf(stderr, "checkpoint %s was written for a different run: %s\n", opts.checkpoint.c_str(), line.c_str());
+        return std::nullopt;
+    }
+    while(std::getline(in, line))
+    {
+        std::istringstream s {line};
+        std::uint64_t shard;
+        tally t;
+        if(!(s >> shard >> t.checked >> t.exact >> t.approximated >> t.max_error))
+        {
+            continue;
+        }
+        for(std::uint64_t& failures : t.failures)
+        {
+            s >> failures;
+        }
+        if(s)
+        {
+            done[shard] = t;
+        }
+    }
+    return done;
+}
+
+using failure_counts = std::array<std::uint64_t, op_names.size()>;
+
+// Baseline file: the same header line as a checkpoint, then one line per operation with its failure count.
+std::optional<failure_counts> load_baseline(const options& opts)
+{
+    std::ifstream in {opts.baseline};
+    std::string line;
+    if(!in || !std::getline(in, line))
+    {
+        std::fprintf(stderr, "cannot read baseline %s\n", opts.baseline.c_str());
+        return std::nullopt;
+    }
+    if(line != describe(opts))
+    {
+        std::fprintf(stderr, "baseline %s was written for a different run: %s\n", opts.baseline.c_str(), line.c_str());
+        return std::nullopt;
+    }
+    failure_counts failures {};
+    while(std::getline(in, line))
+    {
+        std::istringstream s {line};
+        std::string name;
+        std::uint64_t count;
+        if(!(s >> name >> count))
+        {
+            continue;
+        }
+        auto o {std::find(op_names.begin(), op_names.end(), name)};
+        if(o != op_names.end())
+        {
+            failures[static_cast<std::size_t>(o - op_names.begin())] = count;
+        }
+    }
+    return failures;
+}
+
+bool save_baseline(const options& opts, const failure_counts& failures)
+{
+    std::ofstream out {opts.save_baseline, std::ios::trunc};
+    out << describe(opts) << '\n';
+    for(std::size_t i {0}; i < op_names.size(); ++i)
+    {
+        out << op_names[i] << ' ' << failures[i] << '\n';
+    }
+    return static_cast<bool>(out.flush());
+}
+
+template<typename T>
+int run(const options& opts)
+{
+    std::mutex report_mutex;
+    std::atomic<unsigned> reports {0};
+    verifier<T> v {opts, report_mutex, reports};
+
+    std::optional<failure_counts> baseline {};
+    if(!opts.baseline.empty())
+    {
+        baseline = load_baseline(opts);
+        if(!baseline.has_value())
+        {
+            return 2;
+        }
+    }
+
+    tally total;
+    std::vector<std::uint64_t> pending;
+    std::ofstream checkpoint;
+    if(!opts.checkpoint.empty())
+    {
+        std::optional<std::unordered_map<std::uint64_t, tally>> done {load_checkpoint(opts)};
+        if(!done.has_value())
+        {
+            return 2;
+        }
+        for(const auto& [shard, t] : done.value())
+        {
+            total.merge(t);
+        }
+        for(std::uint64_t shard {0}; shard < v.shard_count(); ++shard)
+        {
+            if(!done->contains(shard))
+            {
+                pending.push_back(shard);
+            }
+        }
+        bool fresh {done->empty()};
+        checkpoint.open(opts.checkpoint, fresh ? std::ios::trunc : std::ios::app);
+        if(fresh)
+        {
+            checkpoint << describe(opts) << '\n' << std::flush;
+        }
+        if(!done->empty())
+        {
+            std::fprintf(stderr, "resuming: %zu of %llu shards already done\n", done->size(),
+                static_cast<unsigned long long>(v.shard_count()));
+        }
+    }
+    else
+    {
+        for(std::uint64_t shard {0}; shard < v.shard_count(); ++shard)
+        {
+            pending.push_back(shard);
+        }
+    }
+
+    scheduler pool {opts.threads, pending};
+    std::mutex total_mutex;
+    std::atomic<std::uint64_t> completed {0};
+    std::atomic<std::uint64_t> checked {0};
+    std::atomic<bool> finished {false};
+
+    std::thread progress {[&]()
+    {
+        auto start {std::chrono::steady_clock::now()};
+        auto last {start};
+        while(!finished.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{200});
+            auto now {std::chrono::steady_clock::now()};
+            if(now - last < std::chrono::seconds{2} && !finished.load())
+            {
+                continue;
+            }
+            last = now;
+            double seconds {std::chrono::duration<double>(now - start).count()};
+            double fraction_done {pending.empty() ? 1.0 : static_cast<double>(completed.load())/pending.size()};
+            std::fprintf(stderr, "\r%llu/%zu shards, %.3g checks/s, ETA %.0f s   ",
+                static_cast<unsigned long long>(completed.load()), pending.size(), checked.load()/seconds,
+                fraction_done > 0 ? seconds/fraction_done - seconds : 0.0);
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    for(unsigned w {0}; w < opts.threads; ++w)
+    {
+        workers.emplace_back([&, w]()
+        {
+            for(std::optional<std::uint64_t> shard {pool.next(w)}; shard.has_value(); shard = pool.next(w))
+            {
+                tally t {v.run_shard(shard.value())};
+                checked += t.checked;
+                ++completed;
+                std::lock_guard<std::mutex> lock {total_mutex};
+                total.merge(t);
+                if(checkpoint.is_open())
+                {
+                    checkpoint << shard.value() << ' ' << t.checked << ' ' << t.exact << ' ' << t.approximated << ' '
+                        << t.max_error;
+                    for(std::uint64_t failures : t.failures)
+                    {
+                        checkpoint << ' ' << failures;
+                    }
+                    checkpoint << '\n' << std::flush;
+                }
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    finished = true;
+    progress.join();
+
+    std::printf("\n%s\nchecked %llu, exact %llu, approximated %llu (max relative error %g), failures %llu\n",
+        describe(opts).c_str(), static_cast<unsigned long long>(total.checked),
+        static_cast<unsigned long long>(total.exact), static_cast<unsigned long long>(total.approximated),
+        total.max_error, static_cast<unsigned long long>(total.total_failures()));
+    bool regressed {false};
+    for(std::size_t i {0}; i < op_names.size(); ++i)
+    {
+        if(baseline.has_value() && (total.failures[i] != 0 || (*baseline)[i] != 0))
+        {
+            bool worse {total.failures[i] > (*baseline)[i]};
+            regressed = regressed || worse;
+            std::printf("  %-8s %llu, baseline %llu%s\n", op_names[i],
+                static_cast<unsigned long long>(total.failures[i]), static_cast<unsigned long long>((*baseline)[i]),
+                worse ? ", above the baseline" : "");
+        }
+        else if(total.failures[i] != 0)
+        {
+            std::printf("  %-8s %llu\n", op_names[i], static_cast<unsigned long long>(total.failures[i]));
+        }
+    }
+    if(!opts.save_baseline.empty() && !save_baseline(opts, total.failures))
+    {
+        std::fprintf(stderr, "cannot write baseline %s\n", opts.save_baseline.c_str());
+        return 2;
+    }
+    if(baseline.has_value())
+    {
+        return regressed ? 1 : 0;
+    }
+    return total.total_failures() == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    for(int i {1}; i < argc; ++i)
+    {
+        std::string arg {argv[i]};
+        if(i + 1 >= argc)
+        {
+            std::fprintf(stderr, "usage: verify [--type i8|u8|i16|u16|i32|u32] [--sample N] [--seed S] "
+                "[--threads K] [--checkpoint FILE] [--baseline FILE] [--save-baseline FILE] [--max-reports N]\n");
+            return 2;
+        }
+        std::string value {argv[++i]};
+        if(arg == "--type")
+        {
+            opts.type = value;
+        }
+        else if(arg == "--sample")
+        {
+            opts.sample = std::stoull(value);
+        }
+        else if(arg == "--seed")
+        {
+            opts.seed = std::stoull(value);
+        }
+        else if(arg == "--threads")
+        {
+            opts.threads = std::max(1u, static_cast<unsigned>(std::stoul(value)));
+        }
+        else if(arg == "--checkpoint")
+        {
+            opts.checkpoint = value;
+        }
+        else if(arg == "--baseline")
+        {
+            opts.baseline = value;
+        }
+        else if(arg == "--save-baseline")
+        {
+            opts.save_baseline = value;
+        }
+        else if(arg == "--max-reports")
+        {
+            opts.max_reports = static_cast<unsigned>(std::stoul(value));
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if(opts.sample == 0 && opts.type != "i8" && opts.type != "u8")
+    {
+        std::fprintf(stderr, "the %s space is too large to enumerate; pass --sample N\n", opts.type.c_str());
+        return 2;
+    }
+
+    if(opts.type == "i8")
+    {
+        return run<signed char>(opts);
+    }
+    if(opts.type == "u8")
+    {
+        return run<unsigned char>(opts);
+    }
+    if(opts.type == "i16")
+    {
+        return run<short>(opts);
+    }
+    if(opts.type == "u16")
+    {
+        return run<unsigned short>(opts);
+    }
+    if(opts.type == "i32")
+    {
+        return run<int>(opts);
+    }
+    if(opts.type == "u32")
+    {
+        return run<unsigned int>(opts);
+    }
+    std::fprintf(stderr, "unknown type %s\n", opts.type.c_str());
+    return 2;
+}
@@ -0,0 +1,164 @@
+#include "wide.hpp"
+
+#include <bit>
+#include <limits>
+#include <numeric>
+
+namespace sss
+{
+    namespace wide
+    {
+        template<typename T>
+        struct wider
+        {
+            static_assert(sizeof(T) <= sizeof(std::uint64_t), "no integer type is wider than 128 bits");
+
+            using type = std::conditional_t<
+                std::is_signed<T>::value,
+                std::conditional_t<sizeof(T) == 1, std::int16_t,
+                    std::conditional_t<sizeof(T) == 2, std::int32_t,
+                        std::conditional_t<sizeof(T) == 4, std::int64_t, int128_t>>>,
+                std::conditional_t<sizeof(T) == 1, std::uint16_t,
+                    std::conditional_t<sizeof(T) == 2, std::uint32_t,
+                        std::conditional_t<sizeof(T) == 4, std::uint64_t, uint128_t>>>
+            >;
+        };
+
+        template<typename U>
+        constexpr quotient<U> div_mod(U a, U b) noexcept
+        {
+            if constexpr(sizeof(U) > sizeof(std::uint64_t))
+            {
+                if(a <= std::numeric_limits<std::uint64_t>::max() && b <= std::numeric_limits<std::uint64_t>::max())
+                {
+                    std::uint64_t narrow_a {static_cast<std::uint64_t>(a)};
+                    std::uint64_t narrow_b {static_cast<std::uint64_t>(b)};
+                    return {narrow_a/narrow_b, narrow_a % narrow_b};
+                }
+            }
+            return {a/b, a % b};
+        }
+        template<typename U>
+        constexpr U gcd(U a, U b) noexcept
+        {
+            if constexpr(sizeof(U) <= sizeof(std::uint64_t))
+            {
+                return std::gcd(a, b);
+            }
+            else
+            {
+                for(;;)
+                {
+                    if(a <= std::numeric_limits<std::uint64_t>::max() && b <= std::numeric_limits<std::uint64_t>::max())
+                    {
+                        return std::gcd(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b));
+                    }
+                    if(b == 0)
+                    {
+                        return a;
+                    }
+                    U r {div_mod(a, b).rem};
+                    a = b;
+                    b = r;
+                }
+            }
+        }
+
+        constexpr uint128_t isqrt(uint128_t x) noexcept
+        {
+            if(x < 2)
+            {
+                return x;
+            }
+            uint128_t r {uint128_t(1) << ((bit_width(x) + 1)/2)};
+            for(;;)
+            {
+                uint128_t y {(r + x/r)/2};
+                if(y >= r)
+                {
+                    return r;
+                }
+                r = y;
+            }
+        }
+        constexpr int bit_width(uint128_t x) noexcept
+        {
+            std::uint64_t high {static_cast<std::uint64_t>(x >> 64)};
+            return static_cast<int>(
+                high != 0 ? 64 + std::bit_width(high) : std::bit_width(static_cast<std::uint64_t>(x))
+            );
+        }
+
+        // Schoolbook multiplication on 64-bit halves. The middle sum holds at most three 64-bit values, so it
+        // cannot overflow.
+        constexpr uint256_t mul_full(uint128_t a, uint128_t b) noexcept
+        {
+            constexpr uint128_t mask {std::numeric_limits<std::uint64_t>::max()};
+            uint128_t p00 {(a & mask)*(b & mask)};
+            uint128_t p01 {(a & mask)*(b >> 64)};
+            uint128_t p10 {(a >> 64)*(b & mask)};
+            uint128_t p11 {(a >> 64)*(b >> 64)};
+            uint128_t middle {(p00 >> 64) + (p01 & mask) + (p10 & mask)};
+            return {p11 + (p01 >> 64) + (p10 >> 64) + (middle >> 64), (middle << 64) | (p00 & mask)};
+        }
+        constexpr uint256_t add_full(const uint256_t& a, const uint256_t& b) noexcept
+        {
+            uint128_t low {a.low + b.low};
+            return {a.high + b.high + uint128_t{low < a.low}, low};
+        }
+        constexpr uint256_t sub_full(const uint256_t& a, const uint256_t& b) noexcept
+        {
+            return {a.high - b.high - uint128_t{a.low < b.low}, a.low - b.low};
+        }
+        constexpr uint256_t shift_right(const uint256_t& x, int shift) noexcept
+        {
+            if(shift <= 0)
+            {
+                return x;
+            }
+            if(shift >= 128)
+            {
+                return {0, shift >= 256 ? 0 : x.high >> (shift - 128)};
+            }
+            return {x.high >> shift, (x.low >> shift) | (x.high << (128 - shift))};
+        }
+        constexpr uint256_t shift_left(const uint256_t& x, int shift) noexcept
+        {
+            if(shift <= 0)
+            {
+                return x;
+            }
+            if(shift >= 128)
+            {
+                return {shift >= 256 ? 0 : x.low << (shift - 128), 0};
+            }
+            return {(x.high << shift) | (x.low >> (128 - shift)), x.low << shift};
+        }
+        constexpr int bit_width(const uint256_t& x) noexcept
+        {
+            return x.high != 0 ? 128 + bit_width(x.high) : bit_width(x.low);
+        }
+        // b is lined up under the top bit of a and one bit of the quotient found per shift back, so the cost grows
+        // with the width of the quotient rather than that of a.
+        constexpr quotient<uint256_t> div_mod(const uint256_t& a, const uint256_t& b) noexcept
+        {
+            if(a.high == 0 && b.high == 0)
+            {
+                quotient<uint128_t> q {div_mod(a.low, b.low)};
+                return {{0, q.quot}, {0, q.rem}};
+            }
+            int shift {bit_width(a) - bit_width(b)};
+            quotient<uint256_t> q {{0, 0}, a};
+            for(uint256_t d {shift_left(b, shift)}; shift >= 0; --shift, d = shift_right(d, 1))
+            {
+                q.quot = shift_left(q.quot, 1);
+                if(q.rem >= d)
+                {
+                    q.rem = sub_full(q.rem, d);
+                    q.quot.low |= 1;
+                }
+            }
+            return q;
+        }
+    }
+}
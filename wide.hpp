@@ -0,0 +1,62 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <type_traits>
+
+namespace sss
+{
+    namespace wide
+    {
+        __extension__ typedef __int128 int128_t;
+        __extension__ typedef unsigned __int128 uint128_t;
+
+        template<typename T>
+        struct wider;
+
+        // Integer type with twice the width of T and the same signedness.
+        template<typename T>
+        using wider_t = typename wider<T>::type;
+
+        template<typename U>
+        struct quotient
+        {
+            U quot;
+            U rem;
+        };
+
+        // a/b and a % b for unsigned U. A 128-bit division is a library call even when both operands would fit in
+        // 64 bits, so that case divides natively.
+        template<typename U>
+        [[nodiscard]] constexpr quotient<U> div_mod(U a, U b) noexcept;
+        // Euclid's algorithm on div_mod(), handing over to std::gcd as soon as both values fit in 64 bits.
+        template<typename U>
+        [[nodiscard]] constexpr U gcd(U a, U b) noexcept;
+
+        // floor(sqrt(x)), for values too wide for cia::iroot.
+        [[nodiscard]] constexpr uint128_t isqrt(uint128_t x) noexcept;
+        [[nodiscard]] constexpr int bit_width(uint128_t x) noexcept;
+
+        // A 256-bit magnitude, for the few results whose numerator or denominator is a product of two 128-bit ones.
+        struct uint256_t
+        {
+            uint128_t high;
+            uint128_t low;
+
+            [[nodiscard]] constexpr std::strong_ordering operator<=>(const uint256_t& rhs) const noexcept = default;
+        };
+
+        [[nodiscard]] constexpr uint256_t mul_full(uint128_t a, uint128_t b) noexcept;
+        // a + b, which must not reach 2^256.
+        [[nodiscard]] constexpr uint256_t add_full(const uint256_t& a, const uint256_t& b) noexcept;
+        // a - b, for a >= b.
+        [[nodiscard]] constexpr uint256_t sub_full(const uint256_t& a, const uint256_t& b) noexcept;
+        [[nodiscard]] constexpr uint256_t shift_right(const uint256_t& x, int shift) noexcept;
+        [[nodiscard]] constexpr uint256_t shift_left(const uint256_t& x, int shift) noexcept;
+        [[nodiscard]] constexpr int bit_width(const uint256_t& x) noexcept;
+        // Long division one bit at a time, natively when both values fit in 128 bits.
+        [[nodiscard]] constexpr quotient<uint256_t> div_mod(const uint256_t& a, const uint256_t& b) noexcept;
+    }
+}
+
+#include "wide.cpp"